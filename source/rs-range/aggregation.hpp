@@ -3,8 +3,14 @@
 #include "rs-range/core.hpp"
 #include "rs-tl/iterator.hpp"
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <memory>
 #include <numeric>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
@@ -393,4 +399,139 @@ namespace RS::Range {
 
     const PartialSumObject<std::plus<>> partial_sum = {};
 
+    // split
+
+    namespace Detail {
+
+        // Finds the next occurrence of any of a set of delimiter bytes. One
+        // delimiter uses memchr; up to four are tested eight bytes at a time
+        // with the SWAR zero byte test, and larger sets use a byte table.
+
+        class DelimiterSet {
+        public:
+            explicit DelimiterSet(std::string_view delims): delims_(delims) {
+                for (auto c: delims_)
+                    table_[uint8_t(c)] = true;
+            }
+            const char* find(const char* p, const char* e) const noexcept {
+                if (delims_.empty())
+                    return e;
+                if (delims_.size() == 1) {
+                    auto q = std::memchr(p, delims_[0], size_t(e - p));
+                    return q ? static_cast<const char*>(q) : e;
+                }
+                if (delims_.size() <= 4) {
+                    static constexpr uint64_t ones = 0x0101010101010101ull;
+                    static constexpr uint64_t highs = 0x8080808080808080ull;
+                    for (; e - p >= 8; p += 8) {
+                        uint64_t word;
+                        std::memcpy(&word, p, 8);
+                        uint64_t hits = 0;
+                        for (auto c: delims_) {
+                            uint64_t x = word ^ (ones * uint8_t(c));
+                            hits |= (x - ones) & ~ x & highs;
+                        }
+                        if (hits != 0)
+                            break;
+                    }
+                }
+                for (; p != e && ! table_[uint8_t(*p)]; ++p) {}
+                return p;
+            }
+        private:
+            std::string delims_;
+            std::array<bool, 256> table_ = {};
+        };
+
+    }
+
+    struct SplitObject:
+    AlgorithmBase<SplitObject> {
+        std::string delims;
+        SplitObject(std::string_view d): delims(d) {}
+    };
+
+    class SplitIterator:
+    public TL::ForwardIterator<SplitIterator, const std::string_view> {
+    public:
+        SplitIterator() = default;
+        SplitIterator(const char* b, const char* e, std::shared_ptr<const Detail::DelimiterSet> d,
+                std::shared_ptr<const void> share = {}):
+            begin_(b != e ? b : nullptr), end_(e), delims_(d), share_(share) { if (begin_) next(b); }
+        const std::string_view& operator*() const noexcept { return value_; }
+        SplitIterator& operator++() {
+            auto p = value_.data() + value_.size();
+            if (p == end_)
+                begin_ = nullptr;
+            else
+                next(p + 1);
+            return *this;
+        }
+        bool operator==(const SplitIterator& rhs) const noexcept { return begin_ == rhs.begin_; }
+    private:
+        const char* begin_ = nullptr;
+        const char* end_ = nullptr;
+        std::shared_ptr<const Detail::DelimiterSet> delims_;
+        std::shared_ptr<const void> share_;
+        std::string_view value_;
+        void next(const char* p) {
+            begin_ = p;
+            value_ = std::string_view(p, size_t(delims_->find(p, end_) - p));
+        }
+    };
+
+    template <typename Range>
+    class SplitEachIterator:
+    public TL::ForwardIterator<SplitEachIterator<Range>, const TL::Irange<SplitIterator>> {
+    public:
+        using iterator_category = Detail::CommonCategory<Range, std::forward_iterator_tag>;
+        using underlying_iterator = TL::RangeIterator<const Range>;
+        using value_type = TL::Irange<SplitIterator>;
+        SplitEachIterator() = default;
+        SplitEachIterator(underlying_iterator i, underlying_iterator e, std::shared_ptr<const Detail::DelimiterSet> d):
+            iter_(i), end_(e), delims_(d) { update(); }
+        const value_type& operator*() const noexcept { return value_; }
+        SplitEachIterator& operator++() { ++iter_; update(); return *this; }
+        bool operator==(const SplitEachIterator& rhs) const noexcept { return iter_ == rhs.iter_; }
+    private:
+        underlying_iterator iter_;
+        underlying_iterator end_;
+        std::shared_ptr<const Detail::DelimiterSet> delims_;
+        value_type value_;
+        void update() {
+            if (iter_ == end_)
+                return;
+            using element = std::decay_t<decltype(*iter_)>;
+            if constexpr (std::is_same_v<element, std::string_view>
+                    || (Detail::is_storage_iterator<Range, underlying_iterator>
+                        && std::is_lvalue_reference_v<decltype(*iter_)>)) {
+                std::string_view s(*iter_);
+                value_ = {{s.data(), s.data() + s.size(), delims_}, {}};
+            } else {
+                // Strings computed on the fly (such as map output) may be
+                // overwritten by the next increment, so the fields keep a copy
+                auto text = std::make_shared<const std::string>(std::string_view(*iter_));
+                value_ = {{text->data(), text->data() + text->size(), delims_, text}, {}};
+            }
+        }
+    };
+
+    template <typename Range>
+    auto operator>>(const Range& lhs, const SplitObject& rhs) {
+        auto r = Detail::as_range(lhs);
+        auto b = r.begin(), e = r.end();
+        auto delims = std::make_shared<const Detail::DelimiterSet>(rhs.delims);
+        if constexpr (std::is_same_v<TL::RangeValue<Range>, char>) {
+            static_assert(Detail::is_contiguous_iterator<decltype(b)>);
+            const char* p = b == e ? nullptr : &*b;
+            return TL::Irange<SplitIterator>{{p, p + (e - b), delims}, {}};
+        } else {
+            return TL::Irange<SplitEachIterator<Range>>{{b, e, delims}, {e, e, delims}};
+        }
+    }
+
+    inline SplitObject split(std::string_view delims) {
+        return delims;
+    }
+
 }
@@ -1,15 +1,121 @@
 #pragma once
 
 #include "rs-range/core.hpp"
+#include "rs-range/reduction.hpp"
+#include "rs-range/selection.hpp"
 #include "rs-tl/iterator.hpp"
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <functional>
 #include <iterator>
+#include <numeric>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace RS::Range {
 
+    // cartesian_product
+
+    template <typename... Ranges>
+    class CartesianProductIterator:
+    public Detail::FlexibleIterator<CartesianProductIterator<Ranges...>, const std::tuple<TL::RangeValue<Ranges>...>> {
+    public:
+        static_assert((Detail::category_is_at_least<Ranges, std::forward_iterator_tag> && ...));
+        using iterator_category = Detail::CommonCategory<Ranges..., std::random_access_iterator_tag>;
+        using value_type = std::tuple<TL::RangeValue<Ranges>...>;
+        using iterator_tuple = std::tuple<TL::RangeIterator<const Ranges>...>;
+        static constexpr size_t dimensions = sizeof...(Ranges);
+        CartesianProductIterator() = default;
+        CartesianProductIterator(const iterator_tuple& b, const iterator_tuple& e, bool at_end):
+        begin_(b), current_(b), end_(e) {
+            size_t n = 1;
+            Detail::for_each_index<dimensions>([&] (auto k) {
+                constexpr size_t i = decltype(k)::value;
+                sizes_[i] = std::distance(std::get<i>(b), std::get<i>(e));
+                n *= sizes_[i];
+            });
+            index_ = at_end ? n : 0;
+        }
+        const value_type& operator*() const {
+            if (! ok_) {
+                value_ = std::apply([] (const auto&... is) { return value_type(*is...); }, current_);
+                ok_ = true;
+            }
+            return value_;
+        }
+        value_type operator[](ptrdiff_t i) const { auto t = *this; t += i; return *t; }
+        CartesianProductIterator& operator++() {
+            ++index_;
+            step_up<dimensions - 1>();
+            ok_ = false;
+            return *this;
+        }
+        CartesianProductIterator& operator--() {
+            --index_;
+            step_down<dimensions - 1>();
+            ok_ = false;
+            return *this;
+        }
+        CartesianProductIterator& operator+=(ptrdiff_t rhs) {
+            if (rhs == 0) {
+                return *this;
+            } else if constexpr (std::is_same_v<iterator_category, std::random_access_iterator_tag>) {
+                index_ += rhs;
+                size_t q = index_;
+                Detail::for_each_index_reverse<dimensions>([&] (auto k) {
+                    constexpr size_t i = decltype(k)::value;
+                    std::get<i>(current_) = std::get<i>(begin_) + ptrdiff_t(q % sizes_[i]);
+                    q /= sizes_[i];
+                });
+                ok_ = false;
+            } else {
+                for (; rhs > 0; --rhs)
+                    ++*this;
+                for (; rhs < 0; ++rhs)
+                    --*this;
+            }
+            return *this;
+        }
+        ptrdiff_t operator-(const CartesianProductIterator& rhs) const noexcept { return ptrdiff_t(index_) - ptrdiff_t(rhs.index_); }
+        bool operator==(const CartesianProductIterator& rhs) const noexcept { return index_ == rhs.index_; }
+        size_t index() const noexcept { return index_; }
+        template <size_t K> auto current() const { return std::get<K>(current_); }
+    private:
+        iterator_tuple begin_, current_, end_;
+        std::array<size_t, dimensions> sizes_ = {};
+        size_t index_ = 0;
+        mutable value_type value_ = {};
+        mutable bool ok_ = false;
+        template <size_t K> void step_up() {
+            auto& cur = std::get<K>(current_);
+            if (++cur == std::get<K>(end_)) {
+                cur = std::get<K>(begin_);
+                if constexpr (K > 0)
+                    step_up<K - 1>();
+            }
+        }
+        template <size_t K> void step_down() {
+            auto& cur = std::get<K>(current_);
+            bool carry = cur == std::get<K>(begin_);
+            if (carry)
+                cur = std::get<K>(end_);
+            --cur;
+            if constexpr (K > 0)
+                if (carry)
+                    step_down<K - 1>();
+        }
+    };
+
+    template <typename Range1, typename... Ranges>
+    TL::Irange<CartesianProductIterator<Range1, Ranges...>> cartesian_product(const Range1& r1, const Ranges&... rs) {
+        auto b = std::make_tuple(Detail::as_range(r1).begin(), Detail::as_range(rs).begin()...);
+        auto e = std::make_tuple(Detail::as_range(r1).end(), Detail::as_range(rs).end()...);
+        return {{b, e, false}, {b, e, true}};
+    }
+
     // compare, compare_3way, is_equal, is_equivalent
 
     template <typename Range2, typename ComparisonPredicate>
@@ -48,11 +154,73 @@ namespace RS::Range {
         template <typename CP2> IsEquivalentObject<Range2, CP2> operator()(const CP2& cp) const { return {range, cp}; }
     };
 
+    namespace Detail {
+
+        // Contiguous arrays of the same integral type with the default
+        // predicates are compared bytewise; ordering only needs the first
+        // mismatching element, except for single byte unsigned types where
+        // memcmp order is already numeric order
+
+        template <typename Iterator1, typename Iterator2, typename V = typename std::iterator_traits<Iterator1>::value_type>
+        constexpr bool is_bytewise_comparable = is_contiguous_iterator<Iterator1> && is_contiguous_iterator<Iterator2>
+            && std::is_same_v<V, typename std::iterator_traits<Iterator2>::value_type>
+            && std::is_integral_v<V> && std::has_unique_object_representations_v<V>;
+
+        template <typename Iterator1, typename Iterator2, typename Predicate,
+            typename V = typename std::iterator_traits<Iterator1>::value_type>
+        constexpr bool is_bytewise_less = is_bytewise_comparable<Iterator1, Iterator2>
+            && (std::is_same_v<Predicate, std::less<>> || std::is_same_v<Predicate, std::less<V>>);
+
+        template <typename Iterator1, typename Iterator2, typename Predicate,
+            typename V = typename std::iterator_traits<Iterator1>::value_type>
+        constexpr bool is_bytewise_equal = is_bytewise_comparable<Iterator1, Iterator2>
+            && (std::is_same_v<Predicate, std::equal_to<>> || std::is_same_v<Predicate, std::equal_to<V>>);
+
+        constexpr size_t mismatch_block_bytes = 256;
+
+        template <typename T>
+        size_t mismatch_index(const T* x, const T* y, size_t n) noexcept {
+            constexpr size_t block = std::max(mismatch_block_bytes / sizeof(T), size_t(1));
+            size_t i = 0;
+            for (; i + block <= n; i += block)
+                if (std::memcmp(x + i, y + i, block * sizeof(T)) != 0)
+                    break;
+            while (i < n && x[i] == y[i])
+                ++i;
+            return i;
+        }
+
+        template <typename T>
+        int bytewise_compare_3way(const T* x, size_t n1, const T* y, size_t n2) noexcept {
+            size_t n = std::min(n1, n2);
+            if constexpr (sizeof(T) == 1 && std::is_unsigned_v<T>) {
+                int c = n == 0 ? 0 : std::memcmp(x, y, n);
+                if (c != 0)
+                    return c < 0 ? -1 : 1;
+            } else {
+                size_t k = n == 0 ? 0 : mismatch_index(x, y, n);
+                if (k < n)
+                    return x[k] < y[k] ? -1 : 1;
+            }
+            return n1 < n2 ? -1 : n1 == n2 ? 0 : 1;
+        }
+
+        template <typename T>
+        bool bytewise_equal(const T* x, size_t n1, const T* y, size_t n2) noexcept {
+            return n1 == n2 && (n1 == 0 || std::memcmp(x, y, n1 * sizeof(T)) == 0);
+        }
+
+    }
+
     template <typename Range1, typename Range2, typename ComparisonPredicate>
     bool operator>>(const Range1& lhs, const CompareObject<Range2, ComparisonPredicate>& rhs) {
         auto r = Detail::as_range(lhs);
         auto i = r.begin(), ie = r.end();
         auto j = rhs.range.begin(), je = rhs.range.end();
+        if constexpr (Detail::is_bytewise_less<decltype(i), decltype(j), ComparisonPredicate>) {
+            size_t n1 = ie - i, n2 = je - j;
+            return Detail::bytewise_compare_3way(n1 ? &*i : nullptr, n1, n2 ? &*j : nullptr, n2) < 0;
+        }
         for (; i != ie && j != je; ++i, ++j) {
             if (rhs.comp(*i, *j))
                 return true;
@@ -67,6 +235,10 @@ namespace RS::Range {
         auto r = Detail::as_range(lhs);
         auto i = r.begin(), ie = r.end();
         auto j = rhs.range.begin(), je = rhs.range.end();
+        if constexpr (Detail::is_bytewise_less<decltype(i), decltype(j), ComparisonPredicate>) {
+            size_t n1 = ie - i, n2 = je - j;
+            return Detail::bytewise_compare_3way(n1 ? &*i : nullptr, n1, n2 ? &*j : nullptr, n2);
+        }
         for (; i != ie && j != je; ++i, ++j) {
             if (rhs.comp(*i, *j))
                 return -1;
@@ -88,6 +260,10 @@ namespace RS::Range {
         static constexpr bool ra2 = Detail::category_equals<Range2, std::random_access_iterator_tag>;
         auto i = r.begin(), ie = r.end();
         auto j = rhs.range.begin(), je = rhs.range.end();
+        if constexpr (Detail::is_bytewise_equal<decltype(i), decltype(j), EqualityPredicate>) {
+            size_t n1 = ie - i, n2 = je - j;
+            return Detail::bytewise_equal(n1 ? &*i : nullptr, n1, n2 ? &*j : nullptr, n2);
+        }
         if (ra1 && ra2 && std::distance(i, ie) != std::distance(j, je))
             return false;
         for (; i != ie && j != je; ++i, ++j)
@@ -103,6 +279,10 @@ namespace RS::Range {
         static constexpr bool ra2 = Detail::category_equals<Range2, std::random_access_iterator_tag>;
         auto i = r.begin(), ie = r.end();
         auto j = rhs.range.begin(), je = rhs.range.end();
+        if constexpr (Detail::is_bytewise_less<decltype(i), decltype(j), ComparisonPredicate>) {
+            size_t n1 = ie - i, n2 = je - j;
+            return Detail::bytewise_equal(n1 ? &*i : nullptr, n1, n2 ? &*j : nullptr, n2);
+        }
         if (ra1 && ra2 && std::distance(i, ie) != std::distance(j, je))
             return false;
         for (; i != ie && j != je; ++i, ++j)
@@ -133,11 +313,11 @@ namespace RS::Range {
 
     // concat, prefix
 
-    template <typename Range2>
+    template <typename... Ranges>
     struct ConcatObject:
-    AlgorithmBase<ConcatObject<Range2>> {
-        Detail::AsRange<const Range2> range;
-        ConcatObject(const Range2& r): range(r) {}
+    AlgorithmBase<ConcatObject<Ranges...>> {
+        std::tuple<Detail::AsRange<const Ranges>...> ranges;
+        ConcatObject(const Ranges&... rs): ranges(Detail::AsRange<const Ranges>(rs)...) {}
     };
 
     template <typename Range2>
@@ -147,44 +327,124 @@ namespace RS::Range {
         PrefixObject(const Range2& r): range(r) {}
     };
 
-    template <typename Range1, typename Range2>
+    template <typename... Ranges>
     class ConcatIterator:
-    public TL::ForwardIterator<ConcatIterator<Range1, Range2>, const TL::RangeValue<Range1>> {
+    public Detail::FlexibleIterator<ConcatIterator<Ranges...>, const TL::RangeValue<std::tuple_element_t<0, std::tuple<Ranges...>>>> {
     public:
-        static_assert(std::is_same<TL::RangeValue<Range1>, TL::RangeValue<Range2>>::value);
-        using left_iterator = TL::RangeIterator<const Range1>;
-        using right_iterator = TL::RangeIterator<const Range2>;
-        using iterator_category = Detail::CommonCategory<Range1, Range2, std::forward_iterator_tag>;
+        using value_type = TL::RangeValue<std::tuple_element_t<0, std::tuple<Ranges...>>>;
+        static_assert((std::is_same_v<TL::RangeValue<Ranges>, value_type> && ...));
+        using iterator_category = Detail::CommonCategory<Ranges...>;
+        using iterator_tuple = std::tuple<TL::RangeIterator<const Ranges>...>;
+        static constexpr size_t segments = sizeof...(Ranges);
         ConcatIterator() = default;
-        ConcatIterator(left_iterator b1, left_iterator e1, right_iterator b2): left_(b1), left_end_(e1), right_(b2) {}
-        const auto& operator*() const noexcept { return on_left() ? *left_ : *right_; }
-        ConcatIterator& operator++() { if (on_left()) ++left_; else ++right_; return *this; }
-        bool operator==(const ConcatIterator& rhs) const noexcept { return left_ == rhs.left_ && right_ == rhs.right_; }
+        ConcatIterator(const iterator_tuple& b, const iterator_tuple& e, bool at_end):
+            begin_(b), current_(at_end ? e : b), end_(e), segment_(at_end ? segments - 1 : 0) { settle(); }
+        const value_type& operator*() const {
+            const value_type* ptr = nullptr;
+            Detail::visit_index<segments>(segment_, [&] (auto k) { ptr = &*std::get<decltype(k)::value>(current_); });
+            return *ptr;
+        }
+        ConcatIterator& operator++() {
+            Detail::visit_index<segments>(segment_, [&] (auto k) { ++std::get<decltype(k)::value>(current_); });
+            settle();
+            return *this;
+        }
+        ConcatIterator& operator--() {
+            while (segment_at_begin())
+                --segment_;
+            Detail::visit_index<segments>(segment_, [&] (auto k) { --std::get<decltype(k)::value>(current_); });
+            return *this;
+        }
+        ConcatIterator& operator+=(ptrdiff_t rhs) {
+            while (rhs > 0) {
+                Detail::visit_index<segments>(segment_, [&] (auto k) {
+                    constexpr size_t i = decltype(k)::value;
+                    auto& cur = std::get<i>(current_);
+                    ptrdiff_t step = i + 1 == segments ? rhs : std::min(rhs, ptrdiff_t(std::distance(cur, std::get<i>(end_))));
+                    std::advance(cur, step);
+                    rhs -= step;
+                });
+                settle();
+            }
+            while (rhs < 0) {
+                while (segment_at_begin())
+                    --segment_;
+                Detail::visit_index<segments>(segment_, [&] (auto k) {
+                    constexpr size_t i = decltype(k)::value;
+                    auto& cur = std::get<i>(current_);
+                    ptrdiff_t step = std::min(- rhs, ptrdiff_t(std::distance(std::get<i>(begin_), cur)));
+                    std::advance(cur, - step);
+                    rhs += step;
+                });
+            }
+            return *this;
+        }
+        ptrdiff_t operator-(const ConcatIterator& rhs) const { return position() - rhs.position(); }
+        bool operator==(const ConcatIterator& rhs) const {
+            if (segment_ != rhs.segment_)
+                return false;
+            bool eq = false;
+            Detail::visit_index<segments>(segment_, [&] (auto k) { eq = std::get<decltype(k)::value>(current_) == std::get<decltype(k)::value>(rhs.current_); });
+            return eq;
+        }
+        template <typename SegmentFunction>
+        void for_each_segment(const ConcatIterator& last, SegmentFunction f) const {
+            Detail::for_each_index<segments>([&] (auto k) {
+                constexpr size_t i = decltype(k)::value;
+                if (i >= segment_ && i <= last.segment_)
+                    f(i == segment_ ? std::get<i>(current_) : std::get<i>(begin_),
+                        i == last.segment_ ? std::get<i>(last.current_) : std::get<i>(end_));
+            });
+        }
     private:
-        left_iterator left_, left_end_;
-        right_iterator right_;
-        bool on_left() const noexcept { return left_ != left_end_; }
+        iterator_tuple begin_, current_, end_;
+        size_t segment_ = 0;
+        ptrdiff_t position() const {
+            ptrdiff_t pos = 0;
+            Detail::for_each_index<segments>([&] (auto k) {
+                constexpr size_t i = decltype(k)::value;
+                if (i < segment_)
+                    pos += std::distance(std::get<i>(begin_), std::get<i>(end_));
+                else if (i == segment_)
+                    pos += std::distance(std::get<i>(begin_), std::get<i>(current_));
+            });
+            return pos;
+        }
+        bool segment_at_begin() const {
+            bool at = false;
+            Detail::visit_index<segments>(segment_, [&] (auto k) { at = std::get<decltype(k)::value>(current_) == std::get<decltype(k)::value>(begin_); });
+            return at;
+        }
+        bool segment_at_end() const {
+            bool at = false;
+            Detail::visit_index<segments>(segment_, [&] (auto k) { at = std::get<decltype(k)::value>(current_) == std::get<decltype(k)::value>(end_); });
+            return at;
+        }
+        void settle() {
+            while (segment_ + 1 < segments && segment_at_end())
+                ++segment_;
+        }
     };
 
-    template <typename Range1, typename Range2>
-    TL::Irange<ConcatIterator<Range1, Range2>> operator>>(const Range1& lhs, ConcatObject<Range2> rhs) {
+    template <typename Range1, typename... Ranges>
+    TL::Irange<ConcatIterator<Range1, Ranges...>> operator>>(const Range1& lhs, ConcatObject<Ranges...> rhs) {
         auto r = Detail::as_range(lhs);
-        auto b1 = r.begin(), e1 = r.end();
-        auto b2 = rhs.range.begin(), e2 = rhs.range.end();
-        return {{b1, e1, b2}, {e1, e1, e2}};
+        auto b = std::tuple_cat(std::make_tuple(r.begin()), std::apply([] (auto&... rs) { return std::make_tuple(rs.begin()...); }, rhs.ranges));
+        auto e = std::tuple_cat(std::make_tuple(r.end()), std::apply([] (auto&... rs) { return std::make_tuple(rs.end()...); }, rhs.ranges));
+        return {{b, e, false}, {b, e, true}};
     }
 
     template <typename Range1, typename Range2>
     TL::Irange<ConcatIterator<Range2, Range1>> operator>>(const Range1& lhs, PrefixObject<Range2> rhs) {
         auto r = Detail::as_range(lhs);
-        auto b1 = r.begin(), e1 = r.end();
-        auto b2 = rhs.range.begin(), e2 = rhs.range.end();
-        return {{b2, e2, b1}, {e2, e2, e1}};
+        auto b = std::make_tuple(rhs.range.begin(), r.begin());
+        auto e = std::make_tuple(rhs.range.end(), r.end());
+        return {{b, e, false}, {b, e, true}};
     }
 
-    template <typename Container, typename Range2>
-    Container& operator<<(Container& lhs, ConcatObject<Range2> rhs) {
-        lhs.insert(lhs.end(), rhs.range.begin(), rhs.range.end());
+    template <typename Container, typename... Ranges>
+    Container& operator<<(Container& lhs, ConcatObject<Ranges...> rhs) {
+        std::apply([&lhs] (auto&... rs) { (lhs.insert(lhs.end(), rs.begin(), rs.end()), ...); }, rhs.ranges);
         return lhs;
     }
 
@@ -194,9 +454,9 @@ namespace RS::Range {
         return lhs;
     }
 
-    template <typename Range2>
-    inline ConcatObject<Range2> concat(Range2& r) {
-        return {r};
+    template <typename Range2, typename... Ranges>
+    inline ConcatObject<Range2, Ranges...> concat(Range2& r, Ranges&... rs) {
+        return {r, rs...};
     }
 
     template <typename Range2>
@@ -204,8 +464,321 @@ namespace RS::Range {
         return {r};
     }
 
+    // Terminals on a concatenated range run once per segment
+
+    template <typename... Ranges>
+    auto operator>>(const TL::Irange<ConcatIterator<Ranges...>>& lhs, CollectObject /*rhs*/) {
+        using value_type = typename ConcatIterator<Ranges...>::value_type;
+        std::vector<value_type> vec;
+        if constexpr (Detail::category_is_at_least<ConcatIterator<Ranges...>, std::forward_iterator_tag>) {
+            size_t n = 0;
+            lhs.begin().for_each_segment(lhs.end(), [&n] (auto i, auto j) { n += std::distance(i, j); });
+            vec.reserve(n);
+        }
+        lhs.begin().for_each_segment(lhs.end(), [&vec] (auto i, auto j) { vec.insert(vec.end(), i, j); });
+        return Detail::make_shared_range<value_type>(std::move(vec));
+    }
+
+    template <typename... Ranges, typename UnaryFunction>
+    const TL::Irange<ConcatIterator<Ranges...>>& operator>>(const TL::Irange<ConcatIterator<Ranges...>>& lhs, EachObject<UnaryFunction> rhs) {
+        lhs.begin().for_each_segment(lhs.end(), [&rhs] (auto i, auto j) { std::for_each(i, j, std::ref(rhs.fun)); });
+        return lhs;
+    }
+
+    template <typename... Ranges, typename Container>
+    const TL::Irange<ConcatIterator<Ranges...>>& operator>>(const TL::Irange<ConcatIterator<Ranges...>>& lhs, TL::AppendIterator<Container> rhs) {
+        lhs.begin().for_each_segment(lhs.end(), [&rhs] (auto i, auto j) { rhs = std::copy(i, j, rhs); });
+        return lhs;
+    }
+
+    template <typename... Ranges, typename OutputIterator>
+    void operator>>(const TL::Irange<ConcatIterator<Ranges...>>& lhs, OutputObject<OutputIterator> rhs) {
+        lhs.begin().for_each_segment(lhs.end(), [&rhs] (auto i, auto j) { rhs.iter = std::copy(i, j, rhs.iter); });
+    }
+
+    template <typename... Ranges>
+    size_t operator>>(const TL::Irange<ConcatIterator<Ranges...>>& lhs, CountObject<void> /*rhs*/) {
+        size_t n = 0;
+        lhs.begin().for_each_segment(lhs.end(), [&n] (auto i, auto j) { n += std::distance(i, j); });
+        return n;
+    }
+
+    template <typename... Ranges, typename T>
+    size_t operator>>(const TL::Irange<ConcatIterator<Ranges...>>& lhs, const CountObject<T>& rhs) {
+        size_t n = 0;
+        lhs.begin().for_each_segment(lhs.end(), [&n,&rhs] (auto i, auto j) { n += std::count(i, j, rhs.value); });
+        return n;
+    }
+
+    template <typename... Ranges, typename Predicate>
+    size_t operator>>(const TL::Irange<ConcatIterator<Ranges...>>& lhs, const CountIfObject<Predicate>& rhs) {
+        size_t n = 0;
+        lhs.begin().for_each_segment(lhs.end(), [&n,&rhs] (auto i, auto j) { n += std::count_if(i, j, rhs.pred); });
+        return n;
+    }
+
+    template <typename... Ranges, typename T>
+    T operator>>(const TL::Irange<ConcatIterator<Ranges...>>& lhs, const SumObject<T>& rhs) {
+        T t = rhs.init;
+        lhs.begin().for_each_segment(lhs.end(), [&t] (auto i, auto j) { t = std::accumulate(i, j, std::move(t)); });
+        return t;
+    }
+
+    template <typename... Ranges>
+    auto operator>>(const TL::Irange<ConcatIterator<Ranges...>>& lhs, const SumObject<void>& /*rhs*/) {
+        using value_type = typename ConcatIterator<Ranges...>::value_type;
+        return lhs >> SumObject<value_type>(value_type());
+    }
+
+    // hash_join
+
+    namespace Detail {
+
+        template <typename Key, typename KeyFunction, typename Value>
+            using JoinKeyFunction = std::conditional_t<std::is_void_v<KeyFunction>,
+                IdentityFunction, std::function<Key(const Value&)>>;
+
+        template <typename Range, typename KeyFunction>
+            using JoinKey = std::decay_t<std::invoke_result_t<std::conditional_t<std::is_void_v<KeyFunction>,
+                IdentityFunction, KeyFunction>, const TL::RangeValue<Range>&>>;
+
+        inline size_t mix_hash(size_t h) noexcept {
+            uint64_t x = h;
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ull;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebull;
+            x ^= x >> 31;
+            return size_t(x);
+        }
+
+        // Open addressing table (linear probing, load factor at most 1/2)
+        // over the smaller of the two ranges; slots hold item index + 1
+
+        template <typename Range1, typename Range2, typename Key, typename KeyFunction1, typename KeyFunction2>
+        struct HashJoinTable {
+            using left_iterator = TL::RangeIterator<const Range1>;
+            using right_iterator = TL::RangeIterator<const Range2>;
+            JoinKeyFunction<Key, KeyFunction1, TL::RangeValue<Range1>> left_key;
+            JoinKeyFunction<Key, KeyFunction2, TL::RangeValue<Range2>> right_key;
+            left_iterator left_begin, left_end;
+            right_iterator right_begin, right_end;
+            bool build_left = false;
+            std::vector<left_iterator> lefts;
+            std::vector<right_iterator> rights;
+            std::vector<Key> keys;
+            std::vector<size_t> slots;
+            std::vector<size_t> hashes;
+            size_t mask = 0;
+            template <typename Iterator, typename KeyFunction>
+            void build(Iterator i, Iterator e, size_t n, std::vector<Iterator>& items, const KeyFunction& key) {
+                size_t cap = 1;
+                while (cap < 2 * n)
+                    cap *= 2;
+                mask = cap - 1;
+                slots.assign(cap, 0);
+                hashes.assign(cap, 0);
+                items.reserve(n);
+                keys.reserve(n);
+                for (; i != e; ++i) {
+                    items.push_back(i);
+                    keys.push_back(key(*i));
+                    size_t h = mix_hash(std::hash<Key>()(keys.back()));
+                    size_t slot = h & mask;
+                    while (slots[slot] != 0)
+                        slot = (slot + 1) & mask;
+                    slots[slot] = items.size();
+                    hashes[slot] = h;
+                }
+            }
+        };
+
+    }
+
+    template <typename Range2, typename KeyFunction1, typename KeyFunction2>
+    struct HashJoinObject:
+    AlgorithmBase<HashJoinObject<Range2, KeyFunction1, KeyFunction2>> {
+        Detail::AsRange<const Range2> range;
+        std::conditional_t<std::is_void_v<KeyFunction1>, Detail::IdentityFunction, KeyFunction1> key1;
+        std::conditional_t<std::is_void_v<KeyFunction2>, Detail::IdentityFunction, KeyFunction2> key2;
+        HashJoinObject(const Range2& r): range(r), key1(), key2() {}
+        template <typename KF1, typename KF2> HashJoinObject(const Range2& r, const KF1& k1, const KF2& k2): range(r), key1(k1), key2(k2) {}
+    };
+
+    template <typename ForwardRange1, typename ForwardRange2, typename KeyFunction1, typename KeyFunction2>
+    class HashJoinIterator:
+    public TL::ForwardIterator<HashJoinIterator<ForwardRange1, ForwardRange2, KeyFunction1, KeyFunction2>,
+        const std::pair<TL::RangeValue<ForwardRange1>, TL::RangeValue<ForwardRange2>>> {
+    public:
+        static_assert(Detail::category_is_at_least<ForwardRange1, std::forward_iterator_tag>);
+        static_assert(Detail::category_is_at_least<ForwardRange2, std::forward_iterator_tag>);
+        using key_type = Detail::JoinKey<ForwardRange1, KeyFunction1>;
+        static_assert(std::is_same_v<key_type, Detail::JoinKey<ForwardRange2, KeyFunction2>>);
+        using table_type = Detail::HashJoinTable<ForwardRange1, ForwardRange2, key_type, KeyFunction1, KeyFunction2>;
+        using left_iterator = typename table_type::left_iterator;
+        using right_iterator = typename table_type::right_iterator;
+        using value_type = std::pair<TL::RangeValue<ForwardRange1>, TL::RangeValue<ForwardRange2>>;
+        HashJoinIterator() = default;
+        HashJoinIterator(std::shared_ptr<const table_type> t, bool at_end):
+        table_(t), left_(t->left_begin), right_(t->right_begin) {
+            if (at_end) {
+                if (t->build_left)
+                    right_ = t->right_end;
+                else
+                    left_ = t->left_end;
+            } else {
+                seek();
+            }
+        }
+        const value_type& operator*() const {
+            if (! ok_) {
+                size_t index = table_->slots[slot_] - 1;
+                if (table_->build_left)
+                    value_ = value_type(*table_->lefts[index], *right_);
+                else
+                    value_ = value_type(*left_, *table_->rights[index]);
+                ok_ = true;
+            }
+            return *value_;
+        }
+        HashJoinIterator& operator++() {
+            slot_ = (slot_ + 1) & table_->mask;
+            seek();
+            return *this;
+        }
+        bool operator==(const HashJoinIterator& rhs) const noexcept {
+            return left_ == rhs.left_ && right_ == rhs.right_ && slot_ == rhs.slot_;
+        }
+    private:
+        std::shared_ptr<const table_type> table_;
+        left_iterator left_;
+        right_iterator right_;
+        size_t slot_ = npos;
+        size_t hash_ = 0;
+        std::optional<key_type> key_;
+        mutable std::optional<value_type> value_;
+        mutable bool ok_ = false;
+        void seek() {
+            ok_ = false;
+            auto& t = *table_;
+            for (;;) {
+                if (t.build_left ? right_ == t.right_end : left_ == t.left_end) {
+                    slot_ = npos;
+                    return;
+                }
+                if (slot_ == npos) {
+                    if (t.build_left)
+                        key_ = t.right_key(*right_);
+                    else
+                        key_ = t.left_key(*left_);
+                    hash_ = Detail::mix_hash(std::hash<key_type>()(*key_));
+                    slot_ = hash_ & t.mask;
+                }
+                for (; t.slots[slot_] != 0; slot_ = (slot_ + 1) & t.mask)
+                    if (t.hashes[slot_] == hash_ && t.keys[t.slots[slot_] - 1] == *key_)
+                        return;
+                if (t.build_left)
+                    ++right_;
+                else
+                    ++left_;
+                slot_ = npos;
+            }
+        }
+    };
+
+    template <typename ForwardRange1, typename ForwardRange2, typename KeyFunction1, typename KeyFunction2>
+    TL::Irange<HashJoinIterator<ForwardRange1, ForwardRange2, KeyFunction1, KeyFunction2>>
+    operator>>(const ForwardRange1& lhs, HashJoinObject<ForwardRange2, KeyFunction1, KeyFunction2> rhs) {
+        using iterator = HashJoinIterator<ForwardRange1, ForwardRange2, KeyFunction1, KeyFunction2>;
+        using table_type = typename iterator::table_type;
+        auto r = Detail::as_range(lhs);
+        auto t = std::make_shared<table_type>();
+        t->left_key = rhs.key1;
+        t->right_key = rhs.key2;
+        t->left_begin = r.begin();
+        t->left_end = r.end();
+        t->right_begin = rhs.range.begin();
+        t->right_end = rhs.range.end();
+        size_t n1 = std::distance(t->left_begin, t->left_end);
+        size_t n2 = std::distance(t->right_begin, t->right_end);
+        t->build_left = n1 < n2;
+        if (t->build_left)
+            t->build(t->left_begin, t->left_end, n1, t->lefts, t->left_key);
+        else
+            t->build(t->right_begin, t->right_end, n2, t->rights, t->right_key);
+        return {{t, false}, {t, true}};
+    }
+
+    template <typename ForwardRange2>
+    inline HashJoinObject<ForwardRange2, void, void> hash_join(const ForwardRange2& r) {
+        return {r};
+    }
+
+    template <typename ForwardRange2, typename KeyFunction1, typename KeyFunction2>
+    inline HashJoinObject<ForwardRange2, KeyFunction1, KeyFunction2> hash_join(const ForwardRange2& r, KeyFunction1 k1, KeyFunction2 k2) {
+        return {r, k1, k2};
+    }
+
     // inner_product
 
+    namespace Detail {
+
+        // Dot product with independent accumulators, so the loop can be
+        // vectorised; accumulators are combined in a fixed order
+
+        template <typename T>
+        T dot_product(const T* x, const T* y, size_t n) {
+            constexpr size_t lanes = std::min(std::max(128 / sizeof(T), size_t(8)), size_t(32));
+            T acc[lanes] = {};
+            size_t i = 0;
+            for (; i + lanes <= n; i += lanes)
+                for (size_t k = 0; k < lanes; ++k)
+                    acc[k] += x[i + k] * y[i + k];
+            for (size_t width = lanes / 2; width > 0; width /= 2)
+                for (size_t k = 0; k < width; ++k)
+                    acc[k] += acc[k + width];
+            for (; i < n; ++i)
+                acc[0] += x[i] * y[i];
+            return acc[0];
+        }
+
+        template <typename Iterator1, typename Iterator2, typename T, typename BinaryFunction1, typename BinaryFunction2>
+        constexpr bool is_dot_product =
+            is_contiguous_iterator<Iterator1> && is_contiguous_iterator<Iterator2>
+            && std::is_same_v<typename std::iterator_traits<Iterator1>::value_type, T>
+            && std::is_same_v<typename std::iterator_traits<Iterator2>::value_type, T>
+            && std::is_arithmetic_v<T> && ! std::is_same_v<T, bool>
+            && std::is_same_v<BinaryFunction1, std::multiplies<>> && std::is_same_v<BinaryFunction2, std::plus<>>;
+
+        constexpr size_t inner_product_block_size = 0x1000;
+
+        template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename T,
+            typename BinaryFunction1, typename BinaryFunction2>
+        T parallel_inner_product(RandomAccessIterator1 i, RandomAccessIterator2 j, size_t n, T init,
+                const BinaryFunction1& mul, const BinaryFunction2& add) {
+            size_t blocks = (n + inner_product_block_size - 1) / inner_product_block_size;
+            std::vector<T> partial(blocks, T());
+            size_t tasks = std::min(parallel_tasks(n), std::max(blocks, size_t(1)));
+            parallel_for(tasks, [&] (size_t k) {
+                for (size_t b = blocks * k / tasks, b_end = blocks * (k + 1) / tasks; b < b_end; ++b) {
+                    size_t p = b * inner_product_block_size, q = std::min(p + inner_product_block_size, n);
+                    if constexpr (is_dot_product<RandomAccessIterator1, RandomAccessIterator2, T, BinaryFunction1, BinaryFunction2>) {
+                        partial[b] = dot_product(&*(i + p), &*(j + p), q - p);
+                    } else {
+                        T result = mul(i[p], j[p]);
+                        for (++p; p < q; ++p)
+                            result = add(result, mul(i[p], j[p]));
+                        partial[b] = result;
+                    }
+                }
+            });
+            for (auto& t: partial)
+                init = add(init, t);
+            return init;
+        }
+
+    }
+
     template <typename Range, typename T, typename BinaryFunction1, typename BinaryFunction2>
     struct InnerProductObject:
     AlgorithmBase<InnerProductObject<Range, T, BinaryFunction1, BinaryFunction2>> {
@@ -213,6 +786,7 @@ namespace RS::Range {
         T init;
         BinaryFunction1 mul;
         BinaryFunction2 add;
+        bool parallel = false;
         InnerProductObject(const Range& r, const T& t): range(r), init(t), mul(), add() {}
         InnerProductObject(const Range& r, const T& t, const BinaryFunction1& m, const BinaryFunction2& a):
             range(r), init(t), mul(m), add(a) {}
@@ -223,6 +797,17 @@ namespace RS::Range {
         auto r = Detail::as_range(lhs);
         auto i = r.begin(), e1 = r.end();
         auto j = rhs.range.begin(), e2 = rhs.range.end();
+        using iterator1 = decltype(i);
+        using iterator2 = decltype(j);
+        if constexpr (Detail::category_equals<iterator1, std::random_access_iterator_tag>
+                && Detail::category_equals<iterator2, std::random_access_iterator_tag>) {
+            size_t n = std::min(std::distance(i, e1), std::distance(j, e2));
+            if constexpr (Detail::can_store_in_parallel<T>)
+                if (rhs.parallel)
+                    return Detail::parallel_inner_product(i, j, n, rhs.init, rhs.mul, rhs.add);
+            if constexpr (Detail::is_dot_product<iterator1, iterator2, T, BinaryFunction1, BinaryFunction2>)
+                return n == 0 ? rhs.init : T(rhs.init + Detail::dot_product(&*i, &*j, n));
+        }
         T result = rhs.init;
         for (; i != e1 && j != e2; ++i, ++j)
             result = rhs.add(result, rhs.mul(*i, *j));
@@ -240,66 +825,269 @@ namespace RS::Range {
         return {r, t, f1, f2};
     }
 
-    // interleave
+    template <typename Range>
+    inline InnerProductObject<Range, TL::RangeValue<Range>, std::multiplies<>, std::plus<>> par_inner_product(const Range& r) {
+        auto o = inner_product(r);
+        o.parallel = true;
+        return o;
+    }
+
+    template <typename Range, typename T, typename BinaryFunction1, typename BinaryFunction2>
+    inline InnerProductObject<Range, T, BinaryFunction1, BinaryFunction2>
+    par_inner_product(const Range& r, const T& t, BinaryFunction1 f1, BinaryFunction2 f2) {
+        auto o = inner_product(r, t, f1, f2);
+        o.parallel = true;
+        return o;
+    }
 
-    template <typename Range2>
+    // interleave, deinterleave
+
+    namespace Detail {
+
+        // Fixed-width row loops for the part of an interleaved range where
+        // every component still has elements; with the lane count known at
+        // compile time and raw pointer output the compiler can turn these
+        // into vector shuffles
+
+        template <typename OutputIterator, typename IteratorTuple, size_t... KS>
+        OutputIterator interleave_rows(OutputIterator out, IteratorTuple in, size_t rows, std::index_sequence<KS...>) {
+            constexpr size_t lanes = sizeof...(KS);
+            if constexpr (std::is_pointer_v<OutputIterator>) {
+                for (size_t i = 0; i < rows; ++i)
+                    ((out[lanes * i + KS] = std::get<KS>(in)[i]), ...);
+                return out + lanes * rows;
+            } else {
+                for (size_t i = 0; i < rows; ++i)
+                    ((*out++ = std::get<KS>(in)[i]), ...);
+                return out;
+            }
+        }
+
+        template <size_t N, typename RandomAccessIterator, typename T>
+        void deinterleave_rows(RandomAccessIterator in, size_t rows, T** out) {
+            for (size_t i = 0; i < rows; ++i)
+                for (size_t k = 0; k < N; ++k)
+                    out[k][i] = in[N * i + k];
+        }
+
+        template <typename RandomAccessIterator, typename T>
+        void deinterleave_rows(RandomAccessIterator in, size_t rows, size_t lanes, T** out) {
+            switch (lanes) {
+                case 2:   deinterleave_rows<2>(in, rows, out); break;
+                case 3:   deinterleave_rows<3>(in, rows, out); break;
+                case 4:   deinterleave_rows<4>(in, rows, out); break;
+                default:
+                    for (size_t i = 0; i < rows; ++i)
+                        for (size_t k = 0; k < lanes; ++k)
+                            out[k][i] = in[lanes * i + k];
+                    break;
+            }
+        }
+
+    }
+
+    template <typename... Ranges>
     struct InterleaveObject:
-    AlgorithmBase<InterleaveObject<Range2>> {
-        Detail::AsRange<const Range2> range;
-        InterleaveObject(const Range2& r): range(r) {}
+    AlgorithmBase<InterleaveObject<Ranges...>> {
+        std::tuple<Detail::AsRange<const Ranges>...> ranges;
+        InterleaveObject(const Ranges&... rs): ranges(Detail::AsRange<const Ranges>(rs)...) {}
     };
 
-    template <typename Range1, typename Range2>
+    struct DeinterleaveObject:
+    AlgorithmBase<DeinterleaveObject> {
+        size_t num;
+        DeinterleaveObject(size_t n): num(n) {}
+    };
+
+    template <typename... Ranges>
     class InterleaveIterator:
-    public TL::ForwardIterator<InterleaveIterator<Range1, Range2>, const TL::RangeValue<Range1>> {
+    public TL::ForwardIterator<InterleaveIterator<Ranges...>, const TL::RangeValue<std::tuple_element_t<0, std::tuple<Ranges...>>>> {
     public:
-        static_assert(std::is_same<TL::RangeValue<Range1>, TL::RangeValue<Range2>>::value);
-        using left_iterator = TL::RangeIterator<const Range1>;
-        using right_iterator = TL::RangeIterator<const Range2>;
-        using iterator_category = Detail::CommonCategory<Range1, Range2, std::forward_iterator_tag>;
+        using value_type = TL::RangeValue<std::tuple_element_t<0, std::tuple<Ranges...>>>;
+        static_assert((std::is_same_v<TL::RangeValue<Ranges>, value_type> && ...));
+        using iterator_category = Detail::CommonCategory<Ranges..., std::forward_iterator_tag>;
+        using iterator_tuple = std::tuple<TL::RangeIterator<const Ranges>...>;
+        static constexpr size_t lanes = sizeof...(Ranges);
         InterleaveIterator() = default;
-        InterleaveIterator(left_iterator b1, left_iterator e1, right_iterator b2, right_iterator e2):
-            left_(b1), left_end_(e1), right_(b2), right_end_(e2), on_left_(b1 != e1 || b2 == e2) {}
-        const auto& operator*() const noexcept { return on_left_ ? *left_ : *right_; }
+        InterleaveIterator(const iterator_tuple& i, const iterator_tuple& e): current_(i), end_(e) { settle(); }
+        const value_type& operator*() const {
+            const value_type* ptr = nullptr;
+            Detail::visit_index<lanes>(lane_, [&] (auto k) { ptr = &*std::get<decltype(k)::value>(current_); });
+            return *ptr;
+        }
         InterleaveIterator& operator++() {
-            if (on_left_) {
-                if (left_ != left_end_)
-                    ++left_;
-                on_left_ = right_ == right_end_;
-            } else {
-                if (right_ != right_end_)
-                    ++right_;
-                on_left_ = left_ != left_end_ || right_ == right_end_;
-            }
+            Detail::visit_index<lanes>(lane_, [&] (auto k) { ++std::get<decltype(k)::value>(current_); });
+            ++lane_;
+            settle();
             return *this;
         }
-        bool operator==(const InterleaveIterator& rhs) const noexcept
-            { return left_ == rhs.left_ && right_ == rhs.right_ && on_left_ == rhs.on_left_; }
+        bool operator==(const InterleaveIterator& rhs) const noexcept { return current_ == rhs.current_ && lane_ == rhs.lane_; }
+        size_t remaining() const {
+            size_t n = 0;
+            Detail::for_each_index<lanes>([&] (auto k) { n += std::distance(std::get<decltype(k)::value>(current_), std::get<decltype(k)::value>(end_)); });
+            return n;
+        }
+        template <typename OutputIterator>
+        OutputIterator copy_to(const InterleaveIterator& last, OutputIterator out) const {
+            auto i = *this;
+            if constexpr (std::is_same_v<Detail::CommonCategory<Ranges...>, std::random_access_iterator_tag>) {
+                if (lane_ == 0 && last.exhausted()) {
+                    size_t rows = npos;
+                    Detail::for_each_index<lanes>([&] (auto k) {
+                        rows = std::min(rows, size_t(std::distance(std::get<decltype(k)::value>(current_), std::get<decltype(k)::value>(end_))));
+                    });
+                    out = Detail::interleave_rows(out, current_, rows, std::make_index_sequence<lanes>());
+                    Detail::for_each_index<lanes>([&] (auto k) { std::get<decltype(k)::value>(i.current_) += rows; });
+                    i.settle();
+                }
+            }
+            for (; i != last; ++i, ++out)
+                *out = *i;
+            return out;
+        }
     private:
-        left_iterator left_, left_end_;
-        right_iterator right_, right_end_;
-        bool on_left_;
+        iterator_tuple current_, end_;
+        size_t lane_ = 0;
+        bool lane_at_end(size_t k) const {
+            bool at = false;
+            Detail::visit_index<lanes>(k, [&] (auto i) { at = std::get<decltype(i)::value>(current_) == std::get<decltype(i)::value>(end_); });
+            return at;
+        }
+        bool exhausted() const { return current_ == end_; }
+        void settle() {
+            for (size_t n = 0; n < lanes; ++n, ++lane_) {
+                lane_ %= lanes;
+                if (! lane_at_end(lane_))
+                    return;
+            }
+            lane_ = 0;
+        }
     };
 
-    template <typename Range1, typename Range2>
-    TL::Irange<InterleaveIterator<Range1, Range2>> operator>>(const Range1& lhs, InterleaveObject<Range2> rhs) {
+    template <typename Range>
+    class DeinterleaveIterator:
+    public Detail::FlexibleIterator<DeinterleaveIterator<Range>, const TL::Irange<StrideIterator<Range>>> {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using underlying_iterator = TL::RangeIterator<const Range>;
+        using value_type = TL::Irange<StrideIterator<Range>>;
+        DeinterleaveIterator() = default;
+        DeinterleaveIterator(underlying_iterator b, underlying_iterator e, size_t n, size_t k):
+            begin_(b), end_(e), lanes_(n), lane_(k) {}
+        const value_type& operator*() const {
+            if (! ok_) {
+                value_ = {{begin_, end_, lane_, lanes_}, {end_, end_, 0, 0}};
+                ok_ = true;
+            }
+            return value_;
+        }
+        DeinterleaveIterator& operator++() { ++lane_; ok_ = false; return *this; }
+        DeinterleaveIterator& operator--() { --lane_; ok_ = false; return *this; }
+        DeinterleaveIterator& operator+=(ptrdiff_t rhs) { lane_ += rhs; ok_ = false; return *this; }
+        ptrdiff_t operator-(const DeinterleaveIterator& rhs) const { return ptrdiff_t(lane_) - ptrdiff_t(rhs.lane_); }
+        bool operator==(const DeinterleaveIterator& rhs) const noexcept { return lane_ == rhs.lane_; }
+        underlying_iterator underlying_begin() const noexcept { return begin_; }
+        underlying_iterator underlying_end() const noexcept { return end_; }
+        size_t lanes() const noexcept { return lanes_; }
+        size_t lane() const noexcept { return lane_; }
+    private:
+        underlying_iterator begin_, end_;
+        size_t lanes_ = 1;
+        size_t lane_ = 0;
+        mutable value_type value_;
+        mutable bool ok_ = false;
+    };
+
+    template <typename Range1, typename... Ranges>
+    TL::Irange<InterleaveIterator<Range1, Ranges...>> operator>>(const Range1& lhs, InterleaveObject<Ranges...> rhs) {
         auto r = Detail::as_range(lhs);
-        auto b1 = r.begin(), e1 = r.end();
-        auto b2 = rhs.range.begin(), e2 = rhs.range.end();
-        return {{b1, e1, b2, e2}, {e1, e1, e2, e2}};
+        auto b = std::tuple_cat(std::make_tuple(r.begin()), std::apply([] (auto&... rs) { return std::make_tuple(rs.begin()...); }, rhs.ranges));
+        auto e = std::tuple_cat(std::make_tuple(r.end()), std::apply([] (auto&... rs) { return std::make_tuple(rs.end()...); }, rhs.ranges));
+        return {{b, e}, {e, e}};
     }
 
-    template <typename Container, typename Range2>
-    Container& operator<<(Container& lhs, InterleaveObject<Range2> rhs) {
+    template <typename Range>
+    TL::Irange<DeinterleaveIterator<Range>> operator>>(const Range& lhs, DeinterleaveObject rhs) {
+        auto r = Detail::as_range(lhs);
+        auto b = r.begin(), e = r.end();
+        return {{b, e, rhs.num, 0}, {b, e, rhs.num, rhs.num}};
+    }
+
+    template <typename Container, typename... Ranges>
+    Container& operator<<(Container& lhs, InterleaveObject<Ranges...> rhs) {
         Container temp;
         lhs >> rhs >> append(temp);
         lhs = std::move(temp);
         return lhs;
     }
 
-    template <typename Range2>
-    inline InterleaveObject<Range2> interleave(Range2& r) {
-        return {r};
+    template <typename Range2, typename... Ranges>
+    inline InterleaveObject<Range2, Ranges...> interleave(Range2& r, Ranges&... rs) {
+        return {r, rs...};
+    }
+
+    inline DeinterleaveObject deinterleave(size_t n) {
+        return {n == 0 ? 1 : n};
+    }
+
+    // Copying terminals on an interleaved range use the row loops when every
+    // component is random access
+
+    template <typename... Ranges>
+    auto operator>>(const TL::Irange<InterleaveIterator<Ranges...>>& lhs, CollectObject /*rhs*/) {
+        using value_type = typename InterleaveIterator<Ranges...>::value_type;
+        std::vector<value_type> vec;
+        if constexpr (std::is_default_constructible_v<value_type>) {
+            vec.resize(lhs.begin().remaining() - lhs.end().remaining());
+            lhs.begin().copy_to(lhs.end(), vec.data());
+        } else {
+            vec.reserve(lhs.begin().remaining() - lhs.end().remaining());
+            lhs.begin().copy_to(lhs.end(), std::back_inserter(vec));
+        }
+        return Detail::make_shared_range<value_type>(std::move(vec));
+    }
+
+    template <typename... Ranges, typename Container>
+    const TL::Irange<InterleaveIterator<Ranges...>>& operator>>(const TL::Irange<InterleaveIterator<Ranges...>>& lhs, TL::AppendIterator<Container> rhs) {
+        lhs.begin().copy_to(lhs.end(), rhs);
+        return lhs;
+    }
+
+    template <typename... Ranges, typename OutputIterator>
+    void operator>>(const TL::Irange<InterleaveIterator<Ranges...>>& lhs, OutputObject<OutputIterator> rhs) {
+        lhs.begin().copy_to(lhs.end(), rhs.iter);
+    }
+
+    // Collecting a deinterleaved range materialises every component in one
+    // pass over the source
+
+    template <typename Range>
+    auto operator>>(const TL::Irange<DeinterleaveIterator<Range>>& lhs, CollectObject /*rhs*/) {
+        using value_type = TL::RangeValue<Range>;
+        using iterator = typename DeinterleaveIterator<Range>::underlying_iterator;
+        auto i = lhs.begin();
+        size_t first = i.lane(), last = lhs.end().lane(), lanes = i.lanes();
+        std::vector<std::vector<value_type>> parts;
+        if constexpr (Detail::category_equals<iterator, std::random_access_iterator_tag> && std::is_default_constructible_v<value_type>) {
+            if (first == 0 && last == lanes) {
+                size_t n = std::distance(i.underlying_begin(), i.underlying_end());
+                size_t rows = n / lanes, extra = n % lanes;
+                parts.resize(lanes);
+                std::vector<value_type*> ptrs(lanes);
+                for (size_t k = 0; k < lanes; ++k) {
+                    parts[k].resize(rows + size_t(k < extra));
+                    ptrs[k] = parts[k].data();
+                }
+                auto in = i.underlying_begin();
+                Detail::deinterleave_rows(in, rows, lanes, ptrs.data());
+                for (size_t k = 0; k < extra; ++k)
+                    parts[k][rows] = in[lanes * rows + k];
+                return Detail::make_shared_range<std::vector<value_type>>(std::move(parts));
+            }
+        }
+        for (; i != lhs.end(); ++i)
+            parts.emplace_back(i->begin(), i->end());
+        return Detail::make_shared_range<std::vector<value_type>>(std::move(parts));
     }
 
     // merge
@@ -357,10 +1145,57 @@ namespace RS::Range {
         return {{b1, e1, b2, e2, rhs.comp}, {e1, e1, e2, e2, rhs.comp}};
     }
 
+    namespace Detail {
+
+        // Find the merge path split on diagonal d: the returned i is the
+        // number of elements taken from the first range (d-i from the
+        // second) by the first d steps of a stable merge.
+
+        template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename ComparisonPredicate>
+        size_t merge_path(RandomAccessIterator1 b1, size_t n1, RandomAccessIterator2 b2, size_t n2,
+                size_t d, ComparisonPredicate& comp) {
+            size_t lo = d > n2 ? d - n2 : 0, hi = std::min(d, n1);
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                if (comp(b2[d - mid - 1], b1[mid]))
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            return lo;
+        }
+
+        template <typename Container, typename Range2>
+        constexpr bool can_merge_in_parallel =
+            category_equals<Container, std::random_access_iterator_tag>
+            && category_equals<Range2, std::random_access_iterator_tag>
+            && has_resize<Container>
+            && std::is_default_constructible_v<TL::RangeValue<Container>>
+            && std::is_lvalue_reference_v<decltype(*std::declval<Container&>().begin())>;
+
+    }
+
     template <typename Container, typename SortedRange2, typename ComparisonPredicate>
     Container& operator<<(Container& lhs, MergeObject<SortedRange2, ComparisonPredicate> rhs) {
         Container temp;
-        std::merge(lhs.begin(), lhs.end(), rhs.range.begin(), rhs.range.end(), append(temp), rhs.comp);
+        if constexpr (Detail::can_merge_in_parallel<Container, SortedRange2>) {
+            auto b1 = lhs.begin();
+            auto b2 = rhs.range.begin();
+            size_t n1 = std::distance(b1, lhs.end());
+            size_t n2 = std::distance(b2, rhs.range.end());
+            size_t n = n1 + n2;
+            size_t tasks = Detail::parallel_tasks(n);
+            temp.resize(n);
+            auto out = temp.begin();
+            Detail::parallel_for(tasks, [&] (size_t k) {
+                size_t d1 = n * k / tasks, d2 = n * (k + 1) / tasks;
+                size_t i1 = Detail::merge_path(b1, n1, b2, n2, d1, rhs.comp);
+                size_t i2 = Detail::merge_path(b1, n1, b2, n2, d2, rhs.comp);
+                std::merge(b1 + i1, b1 + i2, b2 + (d1 - i1), b2 + (d2 - i2), out + d1, rhs.comp);
+            });
+        } else {
+            std::merge(lhs.begin(), lhs.end(), rhs.range.begin(), rhs.range.end(), append(temp), rhs.comp);
+        }
         lhs = std::move(temp);
         return lhs;
     }
@@ -375,6 +1210,190 @@ namespace RS::Range {
         return {r, p};
     }
 
+    // merge_join, left_merge_join, semi_merge_join, anti_merge_join
+
+    struct InnerJoinTraits {
+        static constexpr bool pairs = true;
+        static constexpr bool matched = true;
+        static constexpr bool unmatched = false;
+    };
+
+    struct LeftJoinTraits {
+        static constexpr bool pairs = true;
+        static constexpr bool matched = true;
+        static constexpr bool unmatched = true;
+    };
+
+    struct SemiJoinTraits {
+        static constexpr bool pairs = false;
+        static constexpr bool matched = true;
+        static constexpr bool unmatched = false;
+    };
+
+    struct AntiJoinTraits {
+        static constexpr bool pairs = false;
+        static constexpr bool matched = false;
+        static constexpr bool unmatched = true;
+    };
+
+    namespace Detail {
+
+        template <typename Range1, typename Range2, typename JoinTraits>
+        struct JoinResultType { using type = TL::RangeValue<Range1>; };
+        template <typename Range1, typename Range2>
+        struct JoinResultType<Range1, Range2, InnerJoinTraits>
+            { using type = std::pair<TL::RangeValue<Range1>, TL::RangeValue<Range2>>; };
+        template <typename Range1, typename Range2>
+        struct JoinResultType<Range1, Range2, LeftJoinTraits>
+            { using type = std::pair<TL::RangeValue<Range1>, std::optional<TL::RangeValue<Range2>>>; };
+        template <typename Range1, typename Range2, typename JoinTraits>
+            using JoinResult = typename JoinResultType<Range1, Range2, JoinTraits>::type;
+
+    }
+
+    template <typename SortedRange2, typename KeyFunction1, typename KeyFunction2, typename ComparisonPredicate, typename JoinTraits>
+    struct MergeJoinObject:
+    AlgorithmBase<MergeJoinObject<SortedRange2, KeyFunction1, KeyFunction2, ComparisonPredicate, JoinTraits>> {
+        Detail::AsRange<const SortedRange2> range;
+        std::conditional_t<std::is_void_v<KeyFunction1>, Detail::IdentityFunction, KeyFunction1> key1;
+        std::conditional_t<std::is_void_v<KeyFunction2>, Detail::IdentityFunction, KeyFunction2> key2;
+        ComparisonPredicate comp;
+        MergeJoinObject(const SortedRange2& r): range(r), key1(), key2(), comp() {}
+        template <typename R, typename KF1, typename KF2, typename CP> MergeJoinObject(const R& r, const KF1& k1, const KF2& k2, const CP& cp):
+            range(r), key1(k1), key2(k2), comp(cp) {}
+        template <typename CP2> MergeJoinObject<SortedRange2, KeyFunction1, KeyFunction2, CP2, JoinTraits>
+            operator()(const CP2& cp) const { return {range, key1, key2, cp}; }
+    };
+
+    template <typename SortedRange1, typename SortedRange2, typename KeyFunction1, typename KeyFunction2,
+        typename ComparisonPredicate, typename JoinTraits>
+    class MergeJoinIterator:
+    public TL::ForwardIterator<MergeJoinIterator<SortedRange1, SortedRange2, KeyFunction1, KeyFunction2, ComparisonPredicate, JoinTraits>,
+        const Detail::JoinResult<SortedRange1, SortedRange2, JoinTraits>> {
+    public:
+        using key_type = Detail::JoinKey<SortedRange1, KeyFunction1>;
+        static_assert(std::is_same_v<key_type, Detail::JoinKey<SortedRange2, KeyFunction2>>);
+        using left_iterator = TL::RangeIterator<const SortedRange1>;
+        using right_iterator = TL::RangeIterator<const SortedRange2>;
+        using iterator_category = Detail::CommonCategory<SortedRange1, SortedRange2, std::forward_iterator_tag>;
+        using value_type = Detail::JoinResult<SortedRange1, SortedRange2, JoinTraits>;
+        using predicate_type = std::function<bool(const key_type&, const key_type&)>;
+        using join_object = MergeJoinObject<SortedRange2, KeyFunction1, KeyFunction2, ComparisonPredicate, JoinTraits>;
+        MergeJoinIterator() = default;
+        MergeJoinIterator(left_iterator b1, left_iterator e1, right_iterator b2, right_iterator e2, const join_object& j):
+            it1_(b1), end1_(e1), run_(b2), run_end_(b2), cursor_(b2), end2_(e2),
+            key1_(j.key1), key2_(j.key2), comp_(j.comp) { settle(); }
+        const value_type& operator*() const {
+            if (! ok_) {
+                if constexpr (std::is_same_v<JoinTraits, LeftJoinTraits>) {
+                    if (cursor_ == run_end_)
+                        value_ = value_type(*it1_, std::nullopt);
+                    else
+                        value_ = value_type(*it1_, *cursor_);
+                } else if constexpr (JoinTraits::pairs) {
+                    value_ = value_type(*it1_, *cursor_);
+                } else {
+                    value_ = *it1_;
+                }
+                ok_ = true;
+            }
+            return *value_;
+        }
+        MergeJoinIterator& operator++() {
+            if constexpr (JoinTraits::pairs)
+                if (cursor_ != run_end_ && ++cursor_ != run_end_) {
+                    ok_ = false;
+                    return *this;
+                }
+            ++it1_;
+            settle();
+            return *this;
+        }
+        bool operator==(const MergeJoinIterator& rhs) const noexcept { return it1_ == rhs.it1_ && cursor_ == rhs.cursor_; }
+    private:
+        left_iterator it1_, end1_;
+        right_iterator run_, run_end_, cursor_, end2_;
+        Detail::JoinKeyFunction<key_type, KeyFunction1, TL::RangeValue<SortedRange1>> key1_;
+        Detail::JoinKeyFunction<key_type, KeyFunction2, TL::RangeValue<SortedRange2>> key2_;
+        predicate_type comp_;
+        mutable std::optional<value_type> value_;
+        mutable bool ok_ = false;
+        void settle() {
+            ok_ = false;
+            // [run_,run_end_) is the run of right hand elements matching the
+            // current key, kept while successive left keys are equivalent
+            for (; it1_ != end1_; ++it1_) {
+                key_type k = key1_(*it1_);
+                while (run_ != end2_ && comp_(key2_(*run_), k))
+                    run_end_ = ++run_;
+                bool match = run_ != end2_ && ! comp_(k, key2_(*run_));
+                if constexpr (JoinTraits::pairs) {
+                    if (match && run_end_ == run_)
+                        do ++run_end_;
+                        while (run_end_ != end2_ && ! comp_(k, key2_(*run_end_)));
+                    cursor_ = run_;
+                }
+                if (match ? JoinTraits::matched : JoinTraits::unmatched)
+                    return;
+            }
+            run_ = run_end_ = cursor_ = end2_;
+        }
+    };
+
+    template <typename SortedRange1, typename SortedRange2, typename KeyFunction1, typename KeyFunction2,
+        typename ComparisonPredicate, typename JoinTraits>
+    TL::Irange<MergeJoinIterator<SortedRange1, SortedRange2, KeyFunction1, KeyFunction2, ComparisonPredicate, JoinTraits>>
+    operator>>(const SortedRange1& lhs, MergeJoinObject<SortedRange2, KeyFunction1, KeyFunction2, ComparisonPredicate, JoinTraits> rhs) {
+        auto r = Detail::as_range(lhs);
+        auto b1 = r.begin(), e1 = r.end();
+        auto b2 = rhs.range.begin(), e2 = rhs.range.end();
+        return {{b1, e1, b2, e2, rhs}, {e1, e1, e2, e2, rhs}};
+    }
+
+    template <typename SortedRange2>
+    inline MergeJoinObject<SortedRange2, void, void, std::less<>, InnerJoinTraits> merge_join(const SortedRange2& r) {
+        return {r};
+    }
+
+    template <typename SortedRange2, typename KeyFunction1, typename KeyFunction2>
+    inline MergeJoinObject<SortedRange2, KeyFunction1, KeyFunction2, std::less<>, InnerJoinTraits>
+    merge_join(const SortedRange2& r, KeyFunction1 k1, KeyFunction2 k2) {
+        return {r, k1, k2, std::less<>()};
+    }
+
+    template <typename SortedRange2>
+    inline MergeJoinObject<SortedRange2, void, void, std::less<>, LeftJoinTraits> left_merge_join(const SortedRange2& r) {
+        return {r};
+    }
+
+    template <typename SortedRange2, typename KeyFunction1, typename KeyFunction2>
+    inline MergeJoinObject<SortedRange2, KeyFunction1, KeyFunction2, std::less<>, LeftJoinTraits>
+    left_merge_join(const SortedRange2& r, KeyFunction1 k1, KeyFunction2 k2) {
+        return {r, k1, k2, std::less<>()};
+    }
+
+    template <typename SortedRange2>
+    inline MergeJoinObject<SortedRange2, void, void, std::less<>, SemiJoinTraits> semi_merge_join(const SortedRange2& r) {
+        return {r};
+    }
+
+    template <typename SortedRange2, typename KeyFunction1, typename KeyFunction2>
+    inline MergeJoinObject<SortedRange2, KeyFunction1, KeyFunction2, std::less<>, SemiJoinTraits>
+    semi_merge_join(const SortedRange2& r, KeyFunction1 k1, KeyFunction2 k2) {
+        return {r, k1, k2, std::less<>()};
+    }
+
+    template <typename SortedRange2>
+    inline MergeJoinObject<SortedRange2, void, void, std::less<>, AntiJoinTraits> anti_merge_join(const SortedRange2& r) {
+        return {r};
+    }
+
+    template <typename SortedRange2, typename KeyFunction1, typename KeyFunction2>
+    inline MergeJoinObject<SortedRange2, KeyFunction1, KeyFunction2, std::less<>, AntiJoinTraits>
+    anti_merge_join(const SortedRange2& r, KeyFunction1 k1, KeyFunction2 k2) {
+        return {r, k1, k2, std::less<>()};
+    }
+
     // outer_product, self_cross
 
     template <typename ForwardRange, typename BinaryFunction>
@@ -412,11 +1431,12 @@ namespace RS::Range {
 
     template <typename ForwardRange1, typename ForwardRange2, typename BinaryFunction>
     class OuterProductIterator:
-    public TL::ForwardIterator<OuterProductIterator<ForwardRange1, ForwardRange2, BinaryFunction>,
+    public Detail::FlexibleIterator<OuterProductIterator<ForwardRange1, ForwardRange2, BinaryFunction>,
         const Detail::PairResult<ForwardRange1, ForwardRange2, BinaryFunction>> {
     public:
         static_assert(Detail::category_is_at_least<ForwardRange1, std::forward_iterator_tag>);
         static_assert(Detail::category_is_at_least<ForwardRange2, std::forward_iterator_tag>);
+        using iterator_category = Detail::CommonCategory<ForwardRange1, ForwardRange2>;
         using value_type = Detail::PairResult<ForwardRange1, ForwardRange2, BinaryFunction>;
         using left_iterator = TL::RangeIterator<const ForwardRange1>;
         using right_iterator = TL::RangeIterator<const ForwardRange2>;
@@ -424,24 +1444,62 @@ namespace RS::Range {
         using product_object = OuterProductObject<ForwardRange2, BinaryFunction>;
         OuterProductIterator() = default;
         template <typename BinaryFunction2>
-            OuterProductIterator(left_iterator b1, left_iterator e1, right_iterator b2, right_iterator e2, const BinaryFunction2& f):
-            left_(b1), left_end_(e1), right_(b2), right_begin_(b2), right_end_(e2), fun_(f), value_() { update(); }
-        const value_type& operator*() const noexcept { return value_; }
+            OuterProductIterator(left_iterator i1, right_iterator b2, right_iterator e2, const BinaryFunction2& f):
+            left_(i1), right_(b2), right_begin_(b2), right_end_(e2), fun_(f) {}
+        const value_type& operator*() const {
+            if (! ok_) {
+                value_ = fun_(*left_, *right_);
+                ok_ = true;
+            }
+            return value_;
+        }
         OuterProductIterator& operator++() {
             if (++right_ == right_end_) {
                 right_ = right_begin_;
                 ++left_;
             }
-            update();
+            ok_ = false;
+            return *this;
+        }
+        OuterProductIterator& operator--() {
+            if (right_ == right_begin_) {
+                right_ = right_end_;
+                --left_;
+            }
+            --right_;
+            ok_ = false;
             return *this;
         }
-        bool operator==(const OuterProductIterator& rhs) const noexcept { return left_ == rhs.left_ || right_ == rhs.right_; }
+        OuterProductIterator& operator+=(ptrdiff_t rhs) {
+            if (rhs == 0)
+                return *this;
+            ptrdiff_t m = std::distance(right_begin_, right_end_);
+            ptrdiff_t offset = std::distance(right_begin_, right_) + rhs;
+            ptrdiff_t rows = offset / m, columns = offset % m;
+            if (columns < 0) {
+                --rows;
+                columns += m;
+            }
+            std::advance(left_, rows);
+            right_ = std::next(right_begin_, columns);
+            ok_ = false;
+            return *this;
+        }
+        ptrdiff_t operator-(const OuterProductIterator& rhs) const {
+            return std::distance(rhs.left_, left_) * std::distance(right_begin_, right_end_) + std::distance(rhs.right_, right_);
+        }
+        bool operator==(const OuterProductIterator& rhs) const noexcept { return left_ == rhs.left_ && right_ == rhs.right_; }
+        left_iterator left() const { return left_; }
+        right_iterator right() const { return right_; }
+        right_iterator right_begin() const { return right_begin_; }
+        right_iterator right_end() const { return right_end_; }
+        const function_type& function() const noexcept { return fun_; }
     private:
-        left_iterator left_, left_end_;
+        left_iterator left_;
         right_iterator right_, right_begin_, right_end_;
         function_type fun_;
-        value_type value_;
-        void update() { if (left_ != left_end_ && right_ != right_end_) value_ = fun_(*left_, *right_); }
+        mutable value_type value_ = {};
+        mutable bool ok_ = false;
     };
 
     template <typename ForwardRange1, typename ForwardRange2, typename BinaryFunction>
@@ -450,7 +1508,9 @@ namespace RS::Range {
         auto r = Detail::as_range(lhs);
         auto b1 = r.begin(), e1 = r.end();
         auto b2 = rhs.range.begin(), e2 = rhs.range.end();
-        return {{b1, e1, b2, e2, rhs.get_fun()}, {e1, e1, e2, e2, rhs.get_fun()}};
+        if (b2 == e2)
+            b1 = e1;
+        return {{b1, b2, e2, rhs.get_fun()}, {e1, b2, e2, rhs.get_fun()}};
     }
 
     template <typename ForwardRange, typename BinaryFunction>
@@ -458,7 +1518,139 @@ namespace RS::Range {
     operator>>(const ForwardRange& lhs, OuterProductObject<void, BinaryFunction> rhs) {
         auto r = Detail::as_range(lhs);
         auto b = r.begin(), e = r.end();
-        return {{b, e, b, e, rhs.get_fun()}, {e, e, e, e, rhs.get_fun()}};
+        return {{b, b, e, rhs.get_fun()}, {e, b, e, rhs.get_fun()}};
+    }
+
+    namespace Detail {
+
+        // Terminals on a random access outer product visit it in tiles: a
+        // block of rows against a block of columns small enough to stay in
+        // cache while the rows are scanned
+
+        constexpr size_t outer_product_tile_bytes = 0x8000;
+        constexpr size_t outer_product_tile_rows = 64;
+
+        struct OuterProductTile {
+            size_t row;
+            size_t rows;
+            size_t column;
+            size_t columns;
+        };
+
+        template <typename Iterator>
+        constexpr bool is_tiled_outer_product = category_equals<Iterator, std::random_access_iterator_tag>;
+
+        template <typename Iterator>
+        std::vector<OuterProductTile> outer_product_tiles(const Iterator& i, const Iterator& j) {
+            using right_value = typename std::iterator_traits<typename Iterator::right_iterator>::value_type;
+            size_t m = i.right_end() - i.right_begin();
+            size_t rows = j.left() - i.left();
+            size_t c0 = i.right() - i.right_begin(), c1 = j.right() - j.right_begin();
+            size_t tile_columns = std::max(outer_product_tile_bytes / sizeof(right_value), size_t(1));
+            std::vector<OuterProductTile> tiles;
+            if (rows == 0) {
+                if (c0 < c1)
+                    tiles.push_back({0, 1, c0, c1 - c0});
+                return tiles;
+            }
+            size_t first = 0;
+            if (c0 > 0) {
+                tiles.push_back({0, 1, c0, m - c0});
+                first = 1;
+            }
+            for (size_t r = first; r < rows; r += outer_product_tile_rows)
+                for (size_t c = 0; c < m; c += tile_columns)
+                    tiles.push_back({r, std::min(outer_product_tile_rows, rows - r), c, std::min(tile_columns, m - c)});
+            if (c1 > 0)
+                tiles.push_back({rows, 1, 0, c1});
+            return tiles;
+        }
+
+        template <typename Iterator, typename Visitor>
+        void visit_outer_product_tile(const Iterator& i, const OuterProductTile& tile, Visitor v) {
+            auto& f = i.function();
+            size_t m = i.right_end() - i.right_begin();
+            size_t c0 = i.right() - i.right_begin();
+            auto left = i.left() + tile.row;
+            auto right = i.right_begin() + tile.column;
+            for (size_t r = tile.row, r_end = r + tile.rows; r < r_end; ++r, ++left) {
+                size_t index = r * m + tile.column - c0;
+                auto p = right;
+                for (size_t c = 0; c < tile.columns; ++c, ++p)
+                    v(index + c, f(*left, *p));
+            }
+        }
+
+        template <typename Function>
+        void for_each_outer_product_tile(const std::vector<OuterProductTile>& tiles, size_t n, bool parallel, Function f) {
+            size_t tasks = parallel ? std::min(parallel_tasks(n), std::max(tiles.size(), size_t(1))) : 1;
+            parallel_for(tasks, [&] (size_t k) {
+                for (size_t t = tiles.size() * k / tasks, u = tiles.size() * (k + 1) / tasks; t < u; ++t)
+                    f(t);
+            });
+        }
+
+        template <typename Iterator>
+        auto collect_outer_product(const Iterator& i, const Iterator& j, bool parallel) {
+            using value_type = typename Iterator::value_type;
+            if constexpr (is_tiled_outer_product<Iterator> && can_store_in_parallel<value_type>) {
+                size_t n = j - i;
+                auto result = make_shared_range<value_type>(n);
+                auto out = result.begin().iter;
+                auto tiles = outer_product_tiles(i, j);
+                for_each_outer_product_tile(tiles, n, parallel, [&] (size_t t) {
+                    visit_outer_product_tile(i, tiles[t], [&] (size_t k, auto&& x) { out[k] = x; });
+                });
+                return result;
+            } else {
+                return make_shared_range<value_type>(i, j);
+            }
+        }
+
+    }
+
+    template <typename ForwardRange1, typename ForwardRange2, typename BinaryFunction>
+    auto operator>>(const TL::Irange<OuterProductIterator<ForwardRange1, ForwardRange2, BinaryFunction>>& lhs, CollectObject /*rhs*/) {
+        return Detail::collect_outer_product(lhs.begin(), lhs.end(), false);
+    }
+
+    template <typename ForwardRange1, typename ForwardRange2, typename BinaryFunction>
+    auto operator>>(const TL::Irange<OuterProductIterator<ForwardRange1, ForwardRange2, BinaryFunction>>& lhs, ParCollectObject /*rhs*/) {
+        return Detail::collect_outer_product(lhs.begin(), lhs.end(), true);
+    }
+
+    template <typename ForwardRange1, typename ForwardRange2, typename BinaryFunction, typename UnaryFunction>
+    const TL::Irange<OuterProductIterator<ForwardRange1, ForwardRange2, BinaryFunction>>&
+    operator>>(const TL::Irange<OuterProductIterator<ForwardRange1, ForwardRange2, BinaryFunction>>& lhs, ParEachObject<UnaryFunction> rhs) {
+        using iterator = OuterProductIterator<ForwardRange1, ForwardRange2, BinaryFunction>;
+        auto i = lhs.begin(), j = lhs.end();
+        if constexpr (Detail::is_tiled_outer_product<iterator>) {
+            auto tiles = Detail::outer_product_tiles(i, j);
+            Detail::for_each_outer_product_tile(tiles, j - i, true, [&] (size_t t) {
+                Detail::visit_outer_product_tile(i, tiles[t], [&] (size_t, auto&& x) { rhs.fun(x); });
+            });
+        } else {
+            std::for_each(i, j, rhs.fun);
+        }
+        return lhs;
+    }
+
+    template <typename ForwardRange1, typename ForwardRange2, typename BinaryFunction, typename T>
+    T operator>>(const TL::Irange<OuterProductIterator<ForwardRange1, ForwardRange2, BinaryFunction>>& lhs, const ParSumObject<T>& rhs) {
+        using iterator = OuterProductIterator<ForwardRange1, ForwardRange2, BinaryFunction>;
+        auto i = lhs.begin(), j = lhs.end();
+        if constexpr (Detail::is_tiled_outer_product<iterator> && Detail::can_store_in_parallel<T>) {
+            auto tiles = Detail::outer_product_tiles(i, j);
+            std::vector<T> partial(tiles.size(), T());
+            Detail::for_each_outer_product_tile(tiles, j - i, true, [&] (size_t t) {
+                T sum = T();
+                Detail::visit_outer_product_tile(i, tiles[t], [&] (size_t, auto&& x) { sum = sum + x; });
+                partial[t] = sum;
+            });
+            return std::accumulate(partial.begin(), partial.end(), rhs.init);
+        } else {
+            return std::accumulate(i, j, rhs.init);
+        }
     }
 
     template <typename ForwardRange2>
@@ -569,10 +1761,76 @@ namespace RS::Range {
         return {{b1, e1, b2, e2, rhs.comp}, {e1, e1, e2, e2, rhs.comp}};
     }
 
+    namespace Detail {
+
+        template <typename SetTraits, typename InputIterator1, typename InputIterator2,
+            typename OutputIterator, typename ComparisonPredicate>
+        OutputIterator set_operation_copy(InputIterator1 i1, InputIterator1 e1, InputIterator2 i2, InputIterator2 e2,
+                OutputIterator out, ComparisonPredicate& comp) {
+            while (i1 != e1 && i2 != e2) {
+                if (comp(*i1, *i2)) {
+                    if constexpr (SetTraits::left)
+                        *out++ = *i1;
+                    ++i1;
+                } else if (comp(*i2, *i1)) {
+                    if constexpr (SetTraits::right)
+                        *out++ = *i2;
+                    ++i2;
+                } else {
+                    if constexpr (SetTraits::both)
+                        *out++ = *i1;
+                    ++i1;
+                    ++i2;
+                }
+            }
+            if constexpr (SetTraits::left)
+                out = std::copy(i1, e1, out);
+            if constexpr (SetTraits::right)
+                out = std::copy(i2, e2, out);
+            return out;
+        }
+
+    }
+
     template <typename Container, typename SortedRange2, typename ComparisonPredicate, typename SetTraits>
     Container& operator<<(Container& lhs, SetOperationObject<SortedRange2, ComparisonPredicate, SetTraits> rhs) {
         Container temp;
-        lhs >> rhs >> append(temp);
+        auto b1 = lhs.begin(), e1 = lhs.end();
+        auto b2 = rhs.range.begin(), e2 = rhs.range.end();
+        size_t tasks = 1;
+        if constexpr (Detail::can_merge_in_parallel<Container, SortedRange2>)
+            tasks = Detail::parallel_tasks(std::distance(b1, e1) + std::distance(b2, e2));
+        if (tasks == 1) {
+            Detail::set_operation_copy<SetTraits>(b1, e1, b2, e2, append(temp), rhs.comp);
+        } else if constexpr (Detail::can_merge_in_parallel<Container, SortedRange2>) {
+            // Split on the merge path, then move each split back to the start
+            // of its run of equivalent elements so no run straddles two tasks
+            using value_type = TL::RangeValue<Container>;
+            size_t n1 = std::distance(b1, e1), n2 = std::distance(b2, e2), n = n1 + n2;
+            std::vector<size_t> split1(tasks + 1), split2(tasks + 1);
+            split1[tasks] = n1;
+            split2[tasks] = n2;
+            for (size_t k = 1; k < tasks; ++k) {
+                size_t d = n * k / tasks;
+                size_t i = Detail::merge_path(b1, n1, b2, n2, d, rhs.comp), j = d - i;
+                const value_type& pivot = i == n1 || (j < n2 && rhs.comp(b2[j], b1[i])) ? b2[j] : b1[i];
+                split1[k] = std::lower_bound(b1, b1 + i, pivot, rhs.comp) - b1;
+                split2[k] = std::lower_bound(b2, b2 + j, pivot, rhs.comp) - b2;
+            }
+            std::vector<std::vector<value_type>> parts(tasks);
+            Detail::parallel_for(tasks, [&] (size_t k) {
+                Detail::set_operation_copy<SetTraits>(b1 + split1[k], b1 + split1[k + 1],
+                    b2 + split2[k], b2 + split2[k + 1], std::back_inserter(parts[k]), rhs.comp);
+            });
+            std::vector<size_t> offsets(tasks + 1, 0);
+            for (size_t k = 0; k < tasks; ++k)
+                offsets[k + 1] = offsets[k] + parts[k].size();
+            temp.resize(offsets[tasks]);
+            auto out = temp.begin();
+            Detail::parallel_for(tasks, [&] (size_t k) {
+                std::copy(parts[k].begin(), parts[k].end(), out + offsets[k]);
+            });
+        }
         lhs = std::move(temp);
         return lhs;
     }
@@ -629,6 +1887,123 @@ namespace RS::Range {
         return {r, p};
     }
 
+    // soa, collect_soa, column
+
+    template <typename... Columns> class SoaIterator;
+
+    template <typename... Columns>
+    class SoaRow {
+    public:
+        using iterator_tuple = std::tuple<TL::RangeIterator<const Columns>...>;
+        using value_tuple = std::tuple<TL::RangeValue<Columns>...>;
+        SoaRow() = default;
+        SoaRow(const iterator_tuple& b, size_t i): begin_(b), index_(i) {}
+        template <size_t K> decltype(auto) get() const { return std::get<K>(begin_)[ptrdiff_t(index_)]; }
+        size_t index() const noexcept { return index_; }
+        value_tuple values() const { return values(std::index_sequence_for<Columns...>()); }
+    private:
+        friend class SoaIterator<Columns...>;
+        iterator_tuple begin_;
+        size_t index_ = 0;
+        template <size_t... KS> value_tuple values(std::index_sequence<KS...>) const { return value_tuple(get<KS>()...); }
+    };
+
+    template <size_t K, typename... Columns>
+    decltype(auto) get(const SoaRow<Columns...>& row) {
+        return row.template get<K>();
+    }
+
+    template <typename... Columns>
+    class SoaIterator:
+    public Detail::FlexibleIterator<SoaIterator<Columns...>, const SoaRow<Columns...>> {
+    public:
+        static_assert((Detail::category_equals<Columns, std::random_access_iterator_tag> && ...));
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = SoaRow<Columns...>;
+        using iterator_tuple = typename value_type::iterator_tuple;
+        SoaIterator() = default;
+        SoaIterator(const iterator_tuple& b, size_t i): row_(b, i) {}
+        const value_type& operator*() const noexcept { return row_; }
+        value_type operator[](ptrdiff_t i) const noexcept { return value_type(row_.begin_, row_.index_ + i); }
+        SoaIterator& operator++() noexcept { ++row_.index_; return *this; }
+        SoaIterator& operator--() noexcept { --row_.index_; return *this; }
+        SoaIterator& operator+=(ptrdiff_t rhs) noexcept { row_.index_ += rhs; return *this; }
+        ptrdiff_t operator-(const SoaIterator& rhs) const noexcept { return ptrdiff_t(row_.index_) - ptrdiff_t(rhs.row_.index_); }
+        bool operator==(const SoaIterator& rhs) const noexcept { return row_.index_ == rhs.row_.index_; }
+        template <size_t K> auto column() const { return std::get<K>(row_.begin_) + ptrdiff_t(row_.index_); }
+    private:
+        value_type row_;
+    };
+
+    template <typename... Projections>
+    struct CollectSoaObject:
+    AlgorithmBase<CollectSoaObject<Projections...>> {
+        std::tuple<Projections...> projections;
+        CollectSoaObject(const Projections&... ps): projections(ps...) {}
+    };
+
+    template <size_t K>
+    struct SoaColumnObject:
+    AlgorithmBase<SoaColumnObject<K>> {};
+
+    namespace Detail {
+
+        template <typename Range, size_t... KS>
+        auto collect_soa_elements(const Range& r, size_t n, std::index_sequence<KS...>) {
+            using std::get;
+            using value_type = std::decay_t<decltype(*r.begin())>;
+            std::tuple<std::vector<std::decay_t<decltype(get<KS>(std::declval<const value_type&>()))>>...> columns;
+            (std::get<KS>(columns).reserve(n), ...);
+            for (auto& x: r)
+                (std::get<KS>(columns).push_back(get<KS>(x)), ...);
+            return columns;
+        }
+
+        template <typename Range, typename ProjectionTuple, size_t... KS>
+        auto collect_soa_projections(const Range& r, size_t n, const ProjectionTuple& ps, std::index_sequence<KS...>) {
+            using value_type = std::decay_t<decltype(*r.begin())>;
+            std::tuple<std::vector<std::decay_t<std::invoke_result_t<const std::tuple_element_t<KS, ProjectionTuple>&, const value_type&>>>...> columns;
+            (std::get<KS>(columns).reserve(n), ...);
+            for (auto& x: r)
+                (std::get<KS>(columns).push_back(std::invoke(std::get<KS>(ps), x)), ...);
+            return columns;
+        }
+
+    }
+
+    template <typename Range, typename... Projections>
+    auto operator>>(const Range& lhs, const CollectSoaObject<Projections...>& rhs) {
+        auto r = Detail::as_range(lhs);
+        size_t n = 0;
+        if constexpr (Detail::category_is_at_least<Range, std::forward_iterator_tag>)
+            n = std::distance(r.begin(), r.end());
+        if constexpr (sizeof...(Projections) == 0)
+            return Detail::collect_soa_elements(r, n, std::make_index_sequence<std::tuple_size_v<TL::RangeValue<Range>>>());
+        else
+            return Detail::collect_soa_projections(r, n, rhs.projections, std::index_sequence_for<Projections...>());
+    }
+
+    template <typename... Columns, size_t K>
+    auto operator>>(const TL::Irange<SoaIterator<Columns...>>& lhs, SoaColumnObject<K> /*rhs*/) {
+        return TL::Irange<decltype(lhs.begin().template column<K>())>{lhs.begin().template column<K>(), lhs.end().template column<K>()};
+    }
+
+    template <typename... Projections>
+    inline CollectSoaObject<Projections...> collect_soa(Projections... ps) {
+        return {ps...};
+    }
+
+    template <size_t K> constexpr SoaColumnObject<K> column = {};
+
+    template <typename Column1, typename... Columns>
+    TL::Irange<SoaIterator<Column1, Columns...>> soa(const Column1& c1, const Columns&... cs) {
+        auto b = std::make_tuple(Detail::as_range(c1).begin(), Detail::as_range(cs).begin()...);
+        auto size = [] (const auto& c) { auto r = Detail::as_range(c); return size_t(std::distance(r.begin(), r.end())); };
+        size_t n = size(c1);
+        ((n = std::min(n, size(cs))), ...);
+        return {{b, 0}, {b, n}};
+    }
+
     // zip
 
     template <typename Range2, typename BinaryFunction>
@@ -691,3 +2066,16 @@ namespace RS::Range {
     }
 
 }
+
+namespace std {
+
+    template <typename... Columns>
+    struct tuple_size<RS::Range::SoaRow<Columns...>>:
+    std::integral_constant<size_t, sizeof...(Columns)> {};
+
+    template <size_t K, typename... Columns>
+    struct tuple_element<K, RS::Range::SoaRow<Columns...>> {
+        using type = const RS::TL::RangeValue<std::tuple_element_t<K, std::tuple<Columns...>>>;
+    };
+
+}
@@ -4,9 +4,13 @@
 #include "rs-tl/types.hpp"
 #include <algorithm>
 #include <cstdint>
+#include <exception>
 #include <iterator>
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -38,6 +42,12 @@ namespace RS::Range {
             std::true_type {};
         template <typename Con> constexpr bool has_simple_insert = HasSimpleInsert<Con, TL::RangeValue<Con>>::value;
 
+        template <typename Con, typename = void> struct HasResize: std::false_type {};
+        template <typename Con>
+            struct HasResize<Con, std::void_t<decltype(std::declval<Con>().resize(size_t()))>>:
+            std::true_type {};
+        template <typename Con> constexpr bool has_resize = HasResize<Con>::value;
+
         template <typename T, int Path = is_iterator_category<T> ? 1 : TL::is_iterator<T> ? 2 : TL::is_range<T> ? 3 : 0>
             struct IteratorCategoryType;
         template <typename T> struct IteratorCategoryType<T, 1> { using type = T; };
@@ -141,6 +151,47 @@ namespace RS::Range {
             return {i, j};
         }
 
+        // Read only view of storage owned by something other than a vector,
+        // such as a file mapping, which lives as long as any iterator does
+
+        template <typename T>
+        struct MappedIterator:
+        public TL::RandomAccessIterator<MappedIterator<T>, const T> {
+            std::shared_ptr<const void> share;
+            const T* ptr = nullptr;
+            const T& operator*() const noexcept { return *ptr; }
+            MappedIterator& operator+=(ptrdiff_t rhs) noexcept { ptr += rhs; return *this; }
+            ptrdiff_t operator-(const MappedIterator& rhs) const noexcept { return ptr - rhs.ptr; }
+        };
+
+        template <typename T> using MappedRange = TL::Irange<MappedIterator<T>>;
+
+        // Iterators known to address contiguous storage
+
+        template <typename T> constexpr bool is_character_type =
+            std::is_same_v<T, char> || std::is_same_v<T, wchar_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
+
+        template <typename Iterator, typename V = typename std::iterator_traits<Iterator>::value_type,
+            typename Vec = std::vector<std::conditional_t<std::is_object_v<V> && ! std::is_same_v<V, bool>, V, int>>,
+            typename Str = std::basic_string<std::conditional_t<is_character_type<V>, V, char>>,
+            typename View = std::basic_string_view<std::conditional_t<is_character_type<V>, V, char>>>
+        constexpr bool is_contiguous_iterator = std::is_pointer_v<Iterator>
+            || std::is_same_v<Iterator, typename Vec::iterator> || std::is_same_v<Iterator, typename Vec::const_iterator>
+            || std::is_same_v<Iterator, typename Str::iterator> || std::is_same_v<Iterator, typename Str::const_iterator>
+            || std::is_same_v<Iterator, typename View::const_iterator>
+            || (std::is_object_v<V> && ! std::is_same_v<V, bool> && std::is_same_v<Iterator, SharedIterator<V>>)
+            || (std::is_object_v<V> && std::is_same_v<Iterator, MappedIterator<V>>);
+
+        // Iterators into stable storage, either contiguous or belonging to the
+        // source container itself, so a second pass revisits the same objects
+
+        template <typename Con, typename Iterator, typename = void> struct IsContainerIterator: std::false_type {};
+        template <typename Con, typename Iterator>
+            struct IsContainerIterator<Con, Iterator, std::void_t<typename Con::iterator, typename Con::const_iterator>>:
+            std::bool_constant<std::is_same_v<Iterator, typename Con::iterator> || std::is_same_v<Iterator, typename Con::const_iterator>> {};
+        template <typename Con, typename Iterator> constexpr bool is_storage_iterator =
+            is_contiguous_iterator<Iterator> || IsContainerIterator<Con, Iterator>::value;
+
         template <typename Container, typename T>
         void append_to(Container& con, const T& t) {
             if constexpr (Detail::has_push_back<Container>)
@@ -151,6 +202,69 @@ namespace RS::Range {
                 con.insert(con.end(), t);
         }
 
+        // Compile time dispatch over tuple indices: call f(integral_constant<K>)
+        // for each K in 0...N-1, forwards or backwards, or only for the K equal
+        // to a run time index k
+
+        template <typename F, size_t... KS> void for_each_index_sequence(F& f, std::index_sequence<KS...>)
+            { (f(std::integral_constant<size_t, KS>()), ...); }
+        template <size_t N, typename F, size_t... KS> void for_each_index_reverse_sequence(F& f, std::index_sequence<KS...>)
+            { (f(std::integral_constant<size_t, N - 1 - KS>()), ...); }
+        template <size_t N, typename F> void for_each_index(F f)
+            { for_each_index_sequence(f, std::make_index_sequence<N>()); }
+        template <size_t N, typename F> void for_each_index_reverse(F f)
+            { for_each_index_reverse_sequence<N>(f, std::make_index_sequence<N>()); }
+        template <size_t N, typename F> void visit_index(size_t k, F f)
+            { for_each_index<N>([&] (auto i) { if (i == k) f(i); }); }
+
+        // Parallel execution: work is split into tasks of at least grain
+        // elements, never more than one task per hardware thread
+
+        struct ParallelLimits {
+            size_t threads;
+            size_t grain;
+        };
+
+        inline ParallelLimits& parallel_limits() noexcept {
+            static ParallelLimits limits = {std::max(size_t(std::thread::hardware_concurrency()), size_t(1)), 0x10000};
+            return limits;
+        }
+
+        inline size_t parallel_tasks(size_t n) noexcept {
+            auto& limits = parallel_limits();
+            return std::max(std::min(limits.threads, n / std::max(limits.grain, size_t(1))), size_t(1));
+        }
+
+        template <typename Function>
+        void parallel_for(size_t tasks, Function f) {
+            if (tasks <= 1) {
+                if (tasks == 1)
+                    f(size_t(0));
+                return;
+            }
+            std::vector<std::exception_ptr> errors(tasks);
+            std::vector<std::thread> threads;
+            threads.reserve(tasks - 1);
+            for (size_t k = 1; k < tasks; ++k)
+                threads.emplace_back([&f, &errors, k] {
+                    try { f(k); }
+                    catch (...) { errors[k] = std::current_exception(); }
+                });
+            try { f(size_t(0)); }
+            catch (...) { errors[0] = std::current_exception(); }
+            for (auto& t: threads)
+                t.join();
+            for (auto& e: errors)
+                if (e)
+                    std::rethrow_exception(e);
+        }
+
+        // Parallel output goes through a preallocated vector, which must be
+        // default constructible and free of the vector<bool> proxy
+
+        template <typename T> constexpr bool can_store_in_parallel =
+            std::is_default_constructible_v<T> && ! std::is_same_v<T, bool>;
+
     }
 
     template <typename Range, typename Container>
@@ -303,4 +417,60 @@ namespace RS::Range {
         return each([f] (auto& pair) { return f(pair.first, pair.second); });
     }
 
+    // Parallel terminals
+
+    struct ParCollectObject:
+    AlgorithmBase<ParCollectObject> {};
+
+    template <typename Range>
+    auto operator>>(const Range& lhs, ParCollectObject /*rhs*/) {
+        using value_type = TL::RangeValue<Range>;
+        auto r = Detail::as_range(lhs);
+        if constexpr (Detail::category_equals<decltype(r.begin()), std::random_access_iterator_tag>
+                && Detail::can_store_in_parallel<value_type>) {
+            auto b = r.begin();
+            size_t n = std::distance(b, r.end());
+            auto result = Detail::make_shared_range<value_type>(n);
+            auto out = result.begin();
+            size_t tasks = Detail::parallel_tasks(n);
+            Detail::parallel_for(tasks, [=] (size_t k) {
+                size_t i = n * k / tasks, j = n * (k + 1) / tasks;
+                std::copy(b + i, b + j, out + i);
+            });
+            return result;
+        } else {
+            return Detail::make_shared_range<value_type>(r.begin(), r.end());
+        }
+    }
+
+    constexpr ParCollectObject par_collect = {};
+
+    template <typename UnaryFunction>
+    struct ParEachObject:
+    AlgorithmBase<ParEachObject<UnaryFunction>> {
+        UnaryFunction fun;
+        ParEachObject(const UnaryFunction& f): fun(f) {}
+    };
+
+    template <typename Range, typename UnaryFunction>
+    const Range& operator>>(const Range& lhs, ParEachObject<UnaryFunction> rhs) {
+        auto r = Detail::as_range(lhs);
+        if constexpr (Detail::category_equals<decltype(r.begin()), std::random_access_iterator_tag>) {
+            auto b = r.begin();
+            size_t n = std::distance(b, r.end());
+            size_t tasks = Detail::parallel_tasks(n);
+            Detail::parallel_for(tasks, [&] (size_t k) {
+                std::for_each(b + n * k / tasks, b + n * (k + 1) / tasks, rhs.fun);
+            });
+        } else {
+            std::for_each(r.begin(), r.end(), rhs.fun);
+        }
+        return lhs;
+    }
+
+    template <typename UnaryFunction>
+    inline ParEachObject<UnaryFunction> par_each(UnaryFunction f) {
+        return f;
+    }
+
 }
@@ -1,17 +1,65 @@
 #pragma once
 
 #include "rs-range/core.hpp"
+#include "rs-range/reduction.hpp"
+#include "rs-range/selection.hpp"
 #include "rs-tl/iterator.hpp"
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace RS::Range {
 
+    namespace Detail {
+
+        // Exact as long as the result fits in a size_t, otherwise saturates
+        // at npos, so comparisons against a smaller value still hold
+
+        inline size_t binomial(size_t n, size_t k) noexcept {
+            if (k > n)
+                return 0;
+            k = std::min(k, n - k);
+            size_t result = 1;
+            for (size_t i = 1; i <= k; ++i) {
+                size_t g = std::gcd(result, i);
+                size_t factor = (n - k + i) / (i / g);
+                result /= g;
+                if (result > npos / factor)
+                    return npos;
+                result *= factor;
+            }
+            return result;
+        }
+
+        // Largest n whose factorial fits in size_t (20 for 64 bits);
+        // callers must check against this before calling factorial()
+
+        constexpr size_t max_factorial_arg() noexcept {
+            size_t n = 1, f = 1;
+            while (f <= std::numeric_limits<size_t>::max() / (n + 1))
+                f *= ++n;
+            return n;
+        }
+
+        inline size_t factorial(size_t n) noexcept {
+            size_t result = 1;
+            for (size_t i = 2; i <= n; ++i)
+                result *= i;
+            return result;
+        }
+
+    }
+
     // combinations
 
     struct CombinationsObject:
@@ -83,48 +131,118 @@ namespace RS::Range {
         FlatMapObject(const UnaryFunction& f): fun(f) {}
     };
 
+    namespace Detail {
+
+        // Current inner range of a flat_map iterator, held without a heap
+        // allocation. A function that returns a reference is treated as a
+        // view and only the pointer is kept; any other result is stored
+        // inline, and the inner iterators are rebuilt from their offset when
+        // the storage is copied or moved.
+
+        template <typename T, bool IsReference = std::is_lvalue_reference_v<T>>
+        class InnerRange {
+        public:
+            using range_type = std::decay_t<T>;
+            using iterator = TL::RangeIterator<const range_type>;
+            InnerRange() = default;
+            InnerRange(const InnerRange& rhs): range_(rhs.range_), offset_(rhs.offset_) { rebind(); }
+            InnerRange(InnerRange&& rhs) noexcept: range_(std::move(rhs.range_)), offset_(rhs.offset_) { rebind(); }
+            ~InnerRange() = default;
+            InnerRange& operator=(const InnerRange& rhs) {
+                if (&rhs != this) {
+                    range_ = rhs.range_;
+                    offset_ = rhs.offset_;
+                    rebind();
+                }
+                return *this;
+            }
+            InnerRange& operator=(InnerRange&& rhs) noexcept {
+                if (&rhs != this) {
+                    range_ = std::move(rhs.range_);
+                    offset_ = rhs.offset_;
+                    rebind();
+                }
+                return *this;
+            }
+            template <typename F, typename X> void load(F& f, const X& x) { range_.emplace(f(x)); offset_ = 0; rebind(); }
+            void clear() noexcept { range_.reset(); offset_ = 0; }
+            const auto& operator*() const noexcept { return *iter_; }
+            void next() { ++iter_; ++offset_; }
+            bool at_end() const noexcept { return ! range_ || iter_ == end_; }
+            size_t offset() const noexcept { return offset_; }
+        private:
+            std::optional<range_type> range_;
+            iterator iter_, end_;
+            size_t offset_ = 0;
+            void rebind() {
+                if (range_) {
+                    auto r = as_range(*range_);
+                    iter_ = std::next(r.begin(), offset_);
+                    end_ = r.end();
+                }
+            }
+        };
+
+        template <typename T>
+        class InnerRange<T, true> {
+        public:
+            using range_type = std::decay_t<T>;
+            using iterator = TL::RangeIterator<const range_type>;
+            template <typename F, typename X> void load(F& f, const X& x) {
+                range_ = &f(x);
+                auto r = as_range(*range_);
+                iter_ = r.begin();
+                end_ = r.end();
+                offset_ = 0;
+            }
+            void clear() noexcept { range_ = nullptr; offset_ = 0; }
+            const auto& operator*() const noexcept { return *iter_; }
+            void next() { ++iter_; ++offset_; }
+            bool at_end() const noexcept { return ! range_ || iter_ == end_; }
+            size_t offset() const noexcept { return offset_; }
+        private:
+            const range_type* range_ = nullptr;
+            iterator iter_, end_;
+            size_t offset_ = 0;
+        };
+
+    }
+
     template <typename Range, typename UnaryFunction>
     class FlatMapIterator:
     public TL::ForwardIterator<FlatMapIterator<Range, UnaryFunction>,
-        const TL::RangeValue<std::invoke_result_t<UnaryFunction, TL::RangeValue<Range>>>> {
+        const TL::RangeValue<std::decay_t<std::invoke_result_t<UnaryFunction, TL::RangeValue<Range>>>>> {
     public:
         using iterator_category = Detail::CommonCategory<Range, std::forward_iterator_tag>;
         using level_1_iterator = TL::RangeIterator<const Range>;
-        using level_2_range = std::invoke_result_t<UnaryFunction, TL::RangeValue<Range>>;
-        using level_2_iterator = TL::RangeIterator<level_2_range>;
-        using function_type = std::function<level_2_range(const TL::RangeValue<Range>&)>;
+        using level_2_result = std::invoke_result_t<UnaryFunction, TL::RangeValue<Range>>;
+        using level_2_range = std::decay_t<level_2_result>;
+        using function_type = std::function<level_2_result(const TL::RangeValue<Range>&)>;
         FlatMapIterator() = default;
         FlatMapIterator(level_1_iterator b, level_1_iterator e, UnaryFunction f):
-            iter1_(b), end1_(e), range2_(), iter2_(), fun_(f) { update(); }
-        const auto& operator*() const noexcept { return *iter2_; }
+            iter1_(b), end1_(e), fun_(f) { settle(); }
+        const auto& operator*() const noexcept { return *range2_; }
         FlatMapIterator& operator++() {
-            ++iter2_;
-            if (iter2_ == range2_->end()) {
+            range2_.next();
+            if (range2_.at_end()) {
                 ++iter1_;
-                range2_.reset();
-                update();
+                settle();
             }
             return *this;
         }
-        bool operator==(const FlatMapIterator& rhs) const noexcept {
-            if (iter1_ != rhs.iter1_)
-                return false;
-            else if (range2_ && rhs.range2_)
-                return iter2_ == rhs.iter2_;
-            else
-                return ! range2_ && ! rhs.range2_;
-        }
+        bool operator==(const FlatMapIterator& rhs) const noexcept
+            { return iter1_ == rhs.iter1_ && range2_.offset() == rhs.range2_.offset(); }
     private:
         level_1_iterator iter1_, end1_;
-        std::shared_ptr<level_2_range> range2_;
-        level_2_iterator iter2_;
+        Detail::InnerRange<level_2_result> range2_;
         function_type fun_;
-        void update() {
-            if (! range2_ && iter1_ != end1_) {
-                range2_ = std::make_shared<level_2_range>(fun_(*iter1_));
-                auto r = Detail::as_range(*range2_);
-                iter2_ = r.begin();
+        void settle() {
+            for (; iter1_ != end1_; ++iter1_) {
+                range2_.load(fun_, *iter1_);
+                if (! range2_.at_end())
+                    return;
             }
+            range2_.clear();
         }
     };
 
@@ -186,6 +304,20 @@ namespace RS::Range {
             else
                 return iter2_ == rhs.iter2_;
         }
+        template <typename SegmentFunction>
+        void for_each_segment(const FlattenIterator& last, SegmentFunction f) const {
+            auto i1 = iter1_;
+            auto i2 = iter2_;
+            while (i1 != end1_) {
+                bool last_segment = i1 == last.iter1_;
+                auto e2 = last_segment ? last.iter2_ : Detail::as_range(*i1).end();
+                if (i2 != e2)
+                    f(i2, e2);
+                if (last_segment || ++i1 == end1_)
+                    break;
+                i2 = Detail::as_range(*i1).begin();
+            }
+        }
     private:
         level_1_iterator iter1_, end1_;
         level_2_iterator iter2_, end2_;
@@ -209,6 +341,313 @@ namespace RS::Range {
 
     constexpr FlattenObject flatten = {};
 
+    // Terminals on a flattened range run an inner loop over each inner range
+
+    template <typename NestedRange>
+    auto operator>>(const TL::Irange<FlattenIterator<NestedRange>>& lhs, CollectObject /*rhs*/) {
+        using value_type = TL::RangeValue<const TL::RangeValue<NestedRange>>;
+        std::vector<value_type> vec;
+        if constexpr (Detail::category_is_at_least<typename FlattenIterator<NestedRange>::level_2_iterator, std::forward_iterator_tag>) {
+            size_t n = 0;
+            lhs.begin().for_each_segment(lhs.end(), [&n] (auto i, auto j) { n += std::distance(i, j); });
+            vec.reserve(n);
+        }
+        lhs.begin().for_each_segment(lhs.end(), [&vec] (auto i, auto j) { vec.insert(vec.end(), i, j); });
+        return Detail::make_shared_range<value_type>(std::move(vec));
+    }
+
+    template <typename NestedRange, typename UnaryFunction>
+    const TL::Irange<FlattenIterator<NestedRange>>& operator>>(const TL::Irange<FlattenIterator<NestedRange>>& lhs, EachObject<UnaryFunction> rhs) {
+        lhs.begin().for_each_segment(lhs.end(), [&rhs] (auto i, auto j) { std::for_each(i, j, std::ref(rhs.fun)); });
+        return lhs;
+    }
+
+    template <typename NestedRange, typename Container>
+    const TL::Irange<FlattenIterator<NestedRange>>& operator>>(const TL::Irange<FlattenIterator<NestedRange>>& lhs, TL::AppendIterator<Container> rhs) {
+        lhs.begin().for_each_segment(lhs.end(), [&rhs] (auto i, auto j) { rhs = std::copy(i, j, rhs); });
+        return lhs;
+    }
+
+    template <typename NestedRange, typename OutputIterator>
+    void operator>>(const TL::Irange<FlattenIterator<NestedRange>>& lhs, OutputObject<OutputIterator> rhs) {
+        lhs.begin().for_each_segment(lhs.end(), [&rhs] (auto i, auto j) { rhs.iter = std::copy(i, j, rhs.iter); });
+    }
+
+    template <typename NestedRange>
+    size_t operator>>(const TL::Irange<FlattenIterator<NestedRange>>& lhs, CountObject<void> /*rhs*/) {
+        size_t n = 0;
+        lhs.begin().for_each_segment(lhs.end(), [&n] (auto i, auto j) { n += std::distance(i, j); });
+        return n;
+    }
+
+    template <typename NestedRange, typename T>
+    size_t operator>>(const TL::Irange<FlattenIterator<NestedRange>>& lhs, const CountObject<T>& rhs) {
+        size_t n = 0;
+        lhs.begin().for_each_segment(lhs.end(), [&n,&rhs] (auto i, auto j) { n += std::count(i, j, rhs.value); });
+        return n;
+    }
+
+    template <typename NestedRange, typename Predicate>
+    size_t operator>>(const TL::Irange<FlattenIterator<NestedRange>>& lhs, const CountIfObject<Predicate>& rhs) {
+        size_t n = 0;
+        lhs.begin().for_each_segment(lhs.end(), [&n,&rhs] (auto i, auto j) { n += std::count_if(i, j, rhs.pred); });
+        return n;
+    }
+
+    template <typename NestedRange, typename T>
+    T operator>>(const TL::Irange<FlattenIterator<NestedRange>>& lhs, const SumObject<T>& rhs) {
+        T t = rhs.init;
+        lhs.begin().for_each_segment(lhs.end(), [&t] (auto i, auto j) { t = std::accumulate(i, j, std::move(t)); });
+        return t;
+    }
+
+    template <typename NestedRange>
+    auto operator>>(const TL::Irange<FlattenIterator<NestedRange>>& lhs, const SumObject<void>& /*rhs*/) {
+        using value_type = TL::RangeValue<const TL::RangeValue<NestedRange>>;
+        return lhs >> SumObject<value_type>(value_type());
+    }
+
+    // Random access flatten, using a prefix sum index over the inner range sizes
+
+    struct IndexedFlattenObject:
+    AlgorithmBase<IndexedFlattenObject> {};
+
+    template <typename NestedRange>
+    class IndexedFlattenIterator:
+    public Detail::FlexibleIterator<IndexedFlattenIterator<NestedRange>,
+        const TL::RangeValue<const TL::RangeValue<NestedRange>>> {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using level_1_iterator = TL::RangeIterator<const NestedRange>;
+        using level_2_range = TL::RangeValue<NestedRange>;
+        using level_2_iterator = TL::RangeIterator<const level_2_range>;
+        static_assert(Detail::category_is_at_least<level_1_iterator, std::random_access_iterator_tag>);
+        static_assert(Detail::category_is_at_least<level_2_iterator, std::random_access_iterator_tag>);
+        struct index_type {
+            level_1_iterator begin1;
+            std::vector<size_t> offsets;
+        };
+        IndexedFlattenIterator() = default;
+        IndexedFlattenIterator(std::shared_ptr<const index_type> index, bool at_end):
+            index_(index), iter2_(), pos_(at_end ? index->offsets.back() : 0), segment_(0) { locate(); }
+        const auto& operator*() const noexcept { return *iter2_; }
+        IndexedFlattenIterator& operator++() {
+            ++iter2_;
+            if (++pos_ == offsets()[segment_ + 1]) {
+                size_t n = segments();
+                while (segment_ < n && offsets()[segment_ + 1] == pos_)
+                    ++segment_;
+                rebind();
+            }
+            return *this;
+        }
+        IndexedFlattenIterator& operator--() {
+            if (pos_ == offsets()[segment_]) {
+                --pos_;
+                while (offsets()[segment_] > pos_)
+                    --segment_;
+                rebind();
+            } else {
+                --pos_;
+                --iter2_;
+            }
+            return *this;
+        }
+        IndexedFlattenIterator& operator+=(ptrdiff_t rhs) {
+            pos_ += rhs;
+            if (segment_ < segments() && pos_ >= offsets()[segment_] && pos_ < offsets()[segment_ + 1])
+                iter2_ += rhs;
+            else
+                locate();
+            return *this;
+        }
+        ptrdiff_t operator-(const IndexedFlattenIterator& rhs) const noexcept { return ptrdiff_t(pos_) - ptrdiff_t(rhs.pos_); }
+        bool operator==(const IndexedFlattenIterator& rhs) const noexcept { return pos_ == rhs.pos_; }
+        size_t segment() const noexcept { return segment_; }
+        size_t offset() const noexcept { return pos_ - offsets()[segment_]; }
+    private:
+        std::shared_ptr<const index_type> index_;
+        level_2_iterator iter2_;
+        size_t pos_ = 0;
+        size_t segment_ = 0;
+        const std::vector<size_t>& offsets() const noexcept { return index_->offsets; }
+        size_t segments() const noexcept { return offsets().size() - 1; }
+        void locate() {
+            segment_ = std::upper_bound(offsets().begin(), offsets().end(), pos_) - offsets().begin() - 1;
+            rebind();
+        }
+        void rebind() {
+            if (segment_ < segments())
+                iter2_ = Detail::as_range(*(index_->begin1 + segment_)).begin() + (pos_ - offsets()[segment_]);
+            else
+                iter2_ = level_2_iterator();
+        }
+    };
+
+    template <typename NestedRange>
+    TL::Irange<IndexedFlattenIterator<NestedRange>> operator>>(const NestedRange& lhs, IndexedFlattenObject /*rhs*/) {
+        using index_type = typename IndexedFlattenIterator<NestedRange>::index_type;
+        auto index = std::make_shared<index_type>();
+        auto r = Detail::as_range(lhs);
+        index->begin1 = r.begin();
+        index->offsets.reserve(std::distance(r.begin(), r.end()) + 1);
+        index->offsets.push_back(0);
+        for (auto&& inner: r) {
+            auto r2 = Detail::as_range(inner);
+            index->offsets.push_back(index->offsets.back() + std::distance(r2.begin(), r2.end()));
+        }
+        return {{index, false}, {index, true}};
+    }
+
+    constexpr IndexedFlattenObject indexed_flatten = {};
+
+    // heap_permutations, lex_permutations
+
+    // Lexicographic rank of a permutation of 0...n-1 (factorial number system)
+
+    inline size_t permutation_rank(const std::vector<size_t>& indices) noexcept {
+        size_t n = indices.size();
+        size_t rank = 0;
+        for (size_t i = 0; i < n; ++i) {
+            size_t smaller = 0;
+            for (size_t j = i + 1; j < n; ++j)
+                smaller += size_t(indices[j] < indices[i]);
+            rank = rank * (n - i) + smaller;
+        }
+        return rank;
+    }
+
+    struct HeapPermutationsObject:
+    AlgorithmBase<HeapPermutationsObject> {};
+
+    struct LexPermutationsObject:
+    AlgorithmBase<LexPermutationsObject> {};
+
+    template <typename Range>
+    class HeapPermutationsIterator:
+    public TL::ForwardIterator<HeapPermutationsIterator<Range>, const std::vector<TL::RangeValue<Range>>> {
+    public:
+        using value_type = std::vector<TL::RangeValue<Range>>;
+        using range_iterator = TL::RangeIterator<const Range>;
+        HeapPermutationsIterator() = default;
+        HeapPermutationsIterator(range_iterator i, range_iterator j):
+            values_(i, j), counters_(values_.size(), 0), count_(i == j ? npos : 0) {}
+        const value_type& operator*() const noexcept { return values_; }
+        HeapPermutationsIterator& operator++() {
+            // Heap's algorithm, iterative form
+            size_t n = values_.size();
+            for (; level_ < n; ++level_) {
+                size_t& c = counters_[level_];
+                if (c < level_) {
+                    swapped_ = {level_ % 2 == 0 ? 0 : c, level_};
+                    std::swap(values_[swapped_.first], values_[swapped_.second]);
+                    ++c;
+                    level_ = 1;
+                    ++count_;
+                    return *this;
+                }
+                c = 0;
+            }
+            count_ = npos;
+            return *this;
+        }
+        bool operator==(const HeapPermutationsIterator& rhs) const noexcept { return count_ == rhs.count_; }
+        size_t rank() const noexcept { return count_; }
+        std::pair<size_t, size_t> swapped() const noexcept { return swapped_; }
+    private:
+        value_type values_;
+        std::vector<size_t> counters_;
+        size_t level_ = 1;
+        size_t count_ = npos;
+        std::pair<size_t, size_t> swapped_ = {npos, npos};
+    };
+
+    template <typename Range>
+    class LexPermutationsIterator:
+    public Detail::FlexibleIterator<LexPermutationsIterator<Range>, const std::vector<TL::RangeValue<Range>>> {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::vector<TL::RangeValue<Range>>;
+        LexPermutationsIterator() = default;
+        LexPermutationsIterator(std::shared_ptr<const value_type> src, size_t rank):
+            source_(src), rank_(rank), total_(src->empty() ? 0 : Detail::factorial(src->size())) { seek(); }
+        const value_type& operator*() const noexcept { return values_; }
+        value_type operator[](ptrdiff_t i) const { auto t = *this; t += i; return *t; }
+        LexPermutationsIterator& operator++() {
+            if (++rank_ < total_)
+                step();
+            return *this;
+        }
+        LexPermutationsIterator& operator--() { return *this += -1; }
+        LexPermutationsIterator& operator+=(ptrdiff_t rhs) {
+            rank_ += rhs;
+            seek();
+            return *this;
+        }
+        ptrdiff_t operator-(const LexPermutationsIterator& rhs) const noexcept { return ptrdiff_t(rank_ - rhs.rank_); }
+        bool operator==(const LexPermutationsIterator& rhs) const noexcept { return rank_ == rhs.rank_; }
+        const std::vector<size_t>& indices() const noexcept { return indices_; }
+        size_t rank() const noexcept { return rank_; }
+    private:
+        std::shared_ptr<const value_type> source_;
+        size_t rank_ = 0;
+        size_t total_ = 0;
+        std::vector<size_t> indices_;
+        value_type values_;
+        void seek() {
+            if (rank_ >= total_)
+                return;
+            size_t n = source_->size();
+            std::vector<size_t> unused(n);
+            std::iota(unused.begin(), unused.end(), 0);
+            indices_.resize(n);
+            size_t r = rank_, f = total_;
+            for (size_t i = 0; i < n; ++i) {
+                f /= n - i;
+                size_t digit = r / f;
+                r %= f;
+                indices_[i] = unused[digit];
+                unused.erase(unused.begin() + digit);
+            }
+            values_.clear();
+            for (auto i: indices_)
+                values_.push_back((*source_)[i]);
+        }
+        void step() {
+            // Only the suffix changed by next_permutation is copied
+            size_t n = indices_.size(), k = n - 1;
+            while (k > 0 && indices_[k - 1] > indices_[k])
+                --k;
+            size_t l = n - 1;
+            while (indices_[l] < indices_[k - 1])
+                --l;
+            std::swap(indices_[k - 1], indices_[l]);
+            std::reverse(indices_.begin() + k, indices_.end());
+            for (size_t i = k - 1; i < n; ++i)
+                values_[i] = (*source_)[indices_[i]];
+        }
+    };
+
+    template <typename Range>
+    TL::Irange<HeapPermutationsIterator<Range>> operator>>(const Range& lhs, HeapPermutationsObject /*rhs*/) {
+        auto r = Detail::as_range(lhs);
+        return {{r.begin(), r.end()}, {}};
+    }
+
+    template <typename Range>
+    TL::Irange<LexPermutationsIterator<Range>> operator>>(const Range& lhs, LexPermutationsObject /*rhs*/) {
+        using value_type = typename LexPermutationsIterator<Range>::value_type;
+        auto r = Detail::as_range(lhs);
+        auto src = std::make_shared<const value_type>(r.begin(), r.end());
+        if (src->size() > Detail::max_factorial_arg())
+            throw std::length_error("lex_permutations: too many elements to rank");
+        size_t total = src->empty() ? 0 : Detail::factorial(src->size());
+        return {{src, 0}, {src, total}};
+    }
+
+    constexpr HeapPermutationsObject heap_permutations = {};
+    constexpr LexPermutationsObject lex_permutations = {};
+
     // insert_before, insert_after, insert_between, insert_around
 
     template <typename T>
@@ -452,6 +891,159 @@ namespace RS::Range {
         return {t1, t2};
     }
 
+    // mask_subsets
+
+    namespace Detail {
+
+        inline size_t bit_count(uint64_t x) noexcept {
+            x -= (x >> 1) & 0x5555555555555555ull;
+            x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+            x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+            return size_t((x * 0x0101010101010101ull) >> 56);
+        }
+
+        // Index of the lowest set bit (de Bruijn multiplication); x must be nonzero
+
+        inline size_t lowest_bit(uint64_t x) noexcept {
+            static constexpr uint8_t table[64] = {
+                0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+                62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+                63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+                46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6,
+            };
+            return table[((x & (~ x + 1)) * 0x03f79d71b4cb0a89ull) >> 58];
+        }
+
+    }
+
+    class SubsetMask {
+    public:
+        class iterator:
+        public TL::ForwardIterator<iterator, const size_t> {
+        public:
+            iterator() = default;
+            explicit iterator(uint64_t bits) noexcept: bits_(bits), index_(bits == 0 ? 0 : Detail::lowest_bit(bits)) {}
+            const size_t& operator*() const noexcept { return index_; }
+            iterator& operator++() noexcept { *this = iterator(bits_ & (bits_ - 1)); return *this; }
+            bool operator==(const iterator& rhs) const noexcept { return bits_ == rhs.bits_; }
+        private:
+            uint64_t bits_ = 0;
+            size_t index_ = 0;
+        };
+        SubsetMask() = default;
+        explicit SubsetMask(uint64_t mask) noexcept: mask_(mask) {}
+        iterator begin() const noexcept { return iterator(mask_); }
+        iterator end() const noexcept { return {}; }
+        bool contains(size_t i) const noexcept { return i < 64 && ((mask_ >> i) & 1) != 0; }
+        bool empty() const noexcept { return mask_ == 0; }
+        uint64_t mask() const noexcept { return mask_; }
+        size_t size() const noexcept { return Detail::bit_count(mask_); }
+    private:
+        uint64_t mask_ = 0;
+    };
+
+    // Position of a mask in the Gray code sequence
+    inline size_t gray_code_rank(uint64_t mask) noexcept {
+        for (size_t shift = 1; shift < 64; shift *= 2)
+            mask ^= mask >> shift;
+        return size_t(mask);
+    }
+
+    // Position of a mask among masks with the same number of bits, in ascending order
+    inline size_t mask_subset_rank(uint64_t mask) noexcept {
+        size_t rank = 0;
+        for (size_t i = 1; mask != 0; ++i, mask &= mask - 1)
+            rank += Detail::binomial(Detail::lowest_bit(mask), i);
+        return rank;
+    }
+
+    struct MaskSubsetsObject:
+    AlgorithmBase<MaskSubsetsObject> {
+        size_t num = npos;
+        MaskSubsetsObject operator()(size_t k) const noexcept {
+            MaskSubsetsObject o;
+            o.num = k;
+            return o;
+        }
+    };
+
+    class MaskSubsetsIterator:
+    public Detail::FlexibleIterator<MaskSubsetsIterator, const SubsetMask> {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = SubsetMask;
+        MaskSubsetsIterator() = default;
+        MaskSubsetsIterator(size_t n, size_t k, size_t rank):
+            n_(n), k_(k), rank_(rank), total_(k == npos ? size_t(1) << n : Detail::binomial(n, k)) { seek(); }
+        const value_type& operator*() const noexcept { return value_; }
+        value_type operator[](ptrdiff_t i) const noexcept { auto t = *this; t += i; return *t; }
+        MaskSubsetsIterator& operator++() noexcept {
+            if (++rank_ >= total_)
+                return *this;
+            uint64_t x = value_.mask();
+            if (k_ == npos) {
+                changed_ = Detail::lowest_bit(rank_);
+                x ^= uint64_t(1) << changed_;
+            } else {
+                // Gosper's hack
+                uint64_t c = x & (~ x + 1), r = x + c;
+                x = (((r ^ x) >> 2) / c) | r;
+            }
+            value_ = SubsetMask(x);
+            return *this;
+        }
+        MaskSubsetsIterator& operator--() noexcept { return *this += -1; }
+        MaskSubsetsIterator& operator+=(ptrdiff_t rhs) noexcept {
+            rank_ += rhs;
+            seek();
+            return *this;
+        }
+        ptrdiff_t operator-(const MaskSubsetsIterator& rhs) const noexcept { return ptrdiff_t(rank_ - rhs.rank_); }
+        bool operator==(const MaskSubsetsIterator& rhs) const noexcept { return rank_ == rhs.rank_; }
+        size_t changed() const noexcept { return changed_; }
+        size_t rank() const noexcept { return rank_; }
+    private:
+        size_t n_ = 0;
+        size_t k_ = npos;
+        size_t rank_ = 0;
+        size_t total_ = 0;
+        size_t changed_ = npos;
+        value_type value_;
+        void seek() noexcept {
+            changed_ = npos;
+            if (rank_ >= total_)
+                return;
+            if (k_ == npos) {
+                value_ = SubsetMask(rank_ ^ (rank_ >> 1));
+                if (rank_ > 0)
+                    changed_ = Detail::lowest_bit(rank_);
+            } else {
+                // Combinatorial number system
+                uint64_t x = 0;
+                size_t r = rank_, c = n_;
+                for (size_t i = k_; i > 0; --i) {
+                    while (Detail::binomial(c, i) > r)
+                        --c;
+                    x |= uint64_t(1) << c;
+                    r -= Detail::binomial(c, i);
+                }
+                value_ = SubsetMask(x);
+            }
+        }
+    };
+
+    template <typename ForwardRange>
+    TL::Irange<MaskSubsetsIterator> operator>>(const ForwardRange& lhs, MaskSubsetsObject rhs) {
+        auto r = Detail::as_range(lhs);
+        size_t n = std::distance(r.begin(), r.end());
+        if (n > (rhs.num == npos ? 62 : 64))
+            throw std::length_error("mask_subsets: too many elements");
+        size_t total = rhs.num == npos ? size_t(1) << n : Detail::binomial(n, rhs.num);
+        return {{n, rhs.num, 0}, {n, rhs.num, total}};
+    }
+
+    constexpr MaskSubsetsObject mask_subsets = {};
+
     // permutations
 
     template <typename ComparisonPredicate>
@@ -499,6 +1091,47 @@ namespace RS::Range {
 
     // repeat
 
+    namespace Detail {
+
+        // Extend a vector or string whose leading elements hold one period of
+        // a periodic sequence to the given total size; trivially copyable
+        // elements are filled by doubling memcpy
+
+        template <typename Container>
+        void extend_periodic(Container& con, size_t period, size_t total) {
+            using value_type = TL::RangeValue<Container>;
+            if (period == 0 || total <= period)
+                return;
+            if constexpr (std::is_trivially_copyable_v<value_type>) {
+                con.resize(total);
+                value_type* ptr = &*con.begin();
+                for (size_t done = period; done < total;) {
+                    size_t n = std::min(done, total - done);
+                    std::memcpy(ptr + done, ptr, n * sizeof(value_type));
+                    done += n;
+                }
+            } else {
+                con.reserve(total);
+                for (size_t i = period; i < total; ++i)
+                    con.push_back(con[i - period]);
+            }
+        }
+
+        // The scaled terminals and the reflex form have no sensible answer
+        // for an infinite repeat
+
+        inline void check_finite_repeat(ptrdiff_t count, size_t period) {
+            if (count == std::numeric_limits<ptrdiff_t>::max() && period != 0)
+                throw std::length_error("repeat: range is infinite");
+        }
+
+        template <typename RepeatRange>
+        void check_finite_repeat(const RepeatRange& range) {
+            check_finite_repeat(range.end().cycle(), size_t(range.begin().period()));
+        }
+
+    }
+
     struct RepeatObject:
     AlgorithmBase<RepeatObject> {
         ptrdiff_t num = std::numeric_limits<ptrdiff_t>::max();
@@ -519,54 +1152,95 @@ namespace RS::Range {
         using iterator_category = Detail::CommonCategory<FR, std::bidirectional_iterator_tag>;
         RepeatIterator() = default;
         RepeatIterator(underlying_iterator b, underlying_iterator e, ptrdiff_t c):
-            begin_(b), end_(e), iter_(b), cycle_(c) {}
+            begin_(b), end_(e), iter_(b), cycle_(c), index_(0), period_(std::distance(b, e)) {}
         const auto& operator*() const noexcept { return *iter_; }
         RepeatIterator& operator++() {
             ++iter_;
-            if (iter_ == end_) {
+            if (++index_ == period_) {
                 iter_ = begin_;
+                index_ = 0;
                 ++cycle_;
             }
             return *this;
         }
         RepeatIterator& operator--() {
-            if (iter_ == begin_) {
+            if (index_ == 0) {
                 iter_ = end_;
+                index_ = period_;
                 --cycle_;
             }
             --iter_;
+            --index_;
             return *this;
         }
         RepeatIterator& operator+=(ptrdiff_t rhs) {
-            ptrdiff_t offset = std::distance(begin_, iter_) + rhs;
-            ptrdiff_t divisor = std::distance(begin_, end_);
-            ptrdiff_t quo = offset / divisor;
-            ptrdiff_t rem = offset % divisor;
-            if (rem < 0) {
-                --quo;
-                rem += divisor;
-            }
-            cycle_ += quo;
-            iter_ = begin_;
-            std::advance(iter_, rem);
+            ptrdiff_t offset = index_ + rhs;
+            if (rhs == 0 || (offset >= 0 && offset < period_)) {
+                std::advance(iter_, rhs);
+            } else {
+                ptrdiff_t quo = offset / period_;
+                offset %= period_;
+                if (offset < 0) {
+                    --quo;
+                    offset += period_;
+                }
+                cycle_ += quo;
+                iter_ = begin_;
+                std::advance(iter_, offset);
+            }
+            index_ = offset;
             return *this;
         }
-        ptrdiff_t operator-(const RepeatIterator& rhs) const {
-            return (cycle_ - rhs.cycle_) * std::distance(begin_, end_) + std::distance(rhs.iter_, iter_);
+        ptrdiff_t operator-(const RepeatIterator& rhs) const noexcept {
+            // Saturate instead of overflowing, e.g. from the end of an infinite repeat
+            ptrdiff_t cycles = cycle_ - rhs.cycle_;
+            if (cycles == 0)
+                return index_ - rhs.index_;
+            ptrdiff_t limit = (std::numeric_limits<ptrdiff_t>::max() - period_) / period_;
+            if (cycles > limit)
+                return std::numeric_limits<ptrdiff_t>::max();
+            if (cycles < - limit)
+                return std::numeric_limits<ptrdiff_t>::min();
+            return cycles * period_ + index_ - rhs.index_;
         }
         bool operator==(const RepeatIterator& rhs) const noexcept {
-            return cycle_ == rhs.cycle_ && iter_ == rhs.iter_;
+            return cycle_ == rhs.cycle_ && index_ == rhs.index_;
+        }
+        underlying_iterator underlying() const { return iter_; }
+        underlying_iterator underlying_begin() const { return begin_; }
+        underlying_iterator underlying_end() const { return end_; }
+        ptrdiff_t cycle() const noexcept { return cycle_; }
+        ptrdiff_t index() const noexcept { return index_; }
+        ptrdiff_t period() const noexcept { return period_; }
+        template <typename CycleFunction>
+        void for_each_cycle(const RepeatIterator& last, CycleFunction f) const {
+            if (cycle_ == last.cycle_) {
+                if (index_ != last.index_)
+                    f(iter_, last.iter_, ptrdiff_t(1));
+                return;
+            }
+            ptrdiff_t full = last.cycle_ - cycle_ - 1;
+            if (index_ == 0)
+                ++full;
+            else
+                f(iter_, end_, ptrdiff_t(1));
+            if (full > 0)
+                f(begin_, end_, full);
+            if (last.index_ != 0)
+                f(begin_, last.iter_, ptrdiff_t(1));
         }
     private:
         underlying_iterator begin_, end_, iter_;
         ptrdiff_t cycle_ = 0;
+        ptrdiff_t index_ = 0;
+        ptrdiff_t period_ = 0;
     };
 
     template <typename FR>
     TL::Irange<RepeatIterator<FR>> operator>>(const FR& lhs, RepeatObject rhs) {
         auto r = Detail::as_range(lhs);
         auto b = r.begin(), e = r.end();
-        return {{b, e, 0}, {b, e, rhs.num}};
+        return {{b, e, 0}, {b, e, b == e ? 0 : rhs.num}};
     }
 
     template <typename Container>
@@ -574,16 +1248,244 @@ namespace RS::Range {
         if (rhs.num == 0) {
             lhs.clear();
         } else if (rhs.num > 1) {
-            Container temp = lhs;
-            for (ptrdiff_t i = 1; i < rhs.num; ++i)
-                std::copy(lhs.begin(), lhs.end(), append(temp));
-            lhs = std::move(temp);
+            Detail::check_finite_repeat(rhs.num, lhs.size());
+            if (lhs.size() > lhs.max_size() / size_t(rhs.num))
+                throw std::length_error("repeat: result is too long");
+            if constexpr (Detail::is_contiguous_iterator<typename Container::iterator>) {
+                Detail::extend_periodic(lhs, lhs.size(), lhs.size() * rhs.num);
+            } else {
+                Container temp = lhs;
+                for (ptrdiff_t i = 1; i < rhs.num; ++i)
+                    std::copy(lhs.begin(), lhs.end(), append(temp));
+                lhs = std::move(temp);
+            }
         }
         return lhs;
     }
 
+    // Terminals on a repeated range visit each distinct segment of the
+    // underlying range once, scaling by the number of repetitions
+
+    template <typename FR>
+    auto operator>>(const TL::Irange<RepeatIterator<FR>>& lhs, CollectObject /*rhs*/) {
+        using value_type = TL::RangeValue<FR>;
+        Detail::check_finite_repeat(lhs);
+        std::vector<value_type> vec;
+        size_t total = lhs.end() - lhs.begin();
+        size_t period = std::min(total, size_t(lhs.begin().period()));
+        vec.reserve(total);
+        std::copy_n(lhs.begin(), period, std::back_inserter(vec));
+        Detail::extend_periodic(vec, period, total);
+        return Detail::make_shared_range<value_type>(std::move(vec));
+    }
+
+    template <typename FR>
+    size_t operator>>(const TL::Irange<RepeatIterator<FR>>& lhs, CountObject<void> /*rhs*/) {
+        Detail::check_finite_repeat(lhs);
+        return lhs.end() - lhs.begin();
+    }
+
+    template <typename FR, typename T>
+    size_t operator>>(const TL::Irange<RepeatIterator<FR>>& lhs, const CountObject<T>& rhs) {
+        Detail::check_finite_repeat(lhs);
+        size_t n = 0;
+        lhs.begin().for_each_cycle(lhs.end(), [&n,&rhs] (auto i, auto j, ptrdiff_t reps) {
+            n += reps * std::count(i, j, rhs.value);
+        });
+        return n;
+    }
+
+    template <typename FR, typename Predicate>
+    size_t operator>>(const TL::Irange<RepeatIterator<FR>>& lhs, const CountIfObject<Predicate>& rhs) {
+        Detail::check_finite_repeat(lhs);
+        size_t n = 0;
+        lhs.begin().for_each_cycle(lhs.end(), [&n,&rhs] (auto i, auto j, ptrdiff_t reps) {
+            n += reps * std::count_if(i, j, rhs.pred);
+        });
+        return n;
+    }
+
+    template <typename FR, typename T>
+    T operator>>(const TL::Irange<RepeatIterator<FR>>& lhs, const SumObject<T>& rhs) {
+        Detail::check_finite_repeat(lhs);
+        T t = rhs.init;
+        lhs.begin().for_each_cycle(lhs.end(), [&t] (auto i, auto j, ptrdiff_t reps) {
+            if constexpr (std::is_integral_v<T> && ! std::is_same_v<T, bool>) {
+                t += T(reps) * std::accumulate(i, j, T());
+            } else {
+                for (ptrdiff_t k = 0; k < reps; ++k)
+                    t = std::accumulate(i, j, std::move(t));
+            }
+        });
+        return t;
+    }
+
+    template <typename FR>
+    auto operator>>(const TL::Irange<RepeatIterator<FR>>& lhs, const SumObject<void>& /*rhs*/) {
+        using value_type = TL::RangeValue<FR>;
+        return lhs >> SumObject<value_type>(value_type());
+    }
+
+    template <typename FR>
+    TL::Irange<RepeatIterator<FR>> operator>>(const TL::Irange<RepeatIterator<FR>>& lhs, TakeObject rhs) {
+        auto b = lhs.begin(), e = lhs.end();
+        if (b.period() == 0)
+            return lhs;
+        auto t = b + ptrdiff_t(std::min(rhs.num, size_t(std::numeric_limits<ptrdiff_t>::max() - b.period())));
+        if (t.cycle() < e.cycle() || (t.cycle() == e.cycle() && t.index() < e.index()))
+            e = t;
+        return {b, e};
+    }
+
     constexpr RepeatObject repeat = {};
 
+    // revolving_door
+
+    // Revolving door rank (Kreher & Stinson); indices must be sorted and distinct
+
+    inline size_t revolving_door_rank(const std::vector<size_t>& indices) noexcept {
+        size_t k = indices.size();
+        size_t rank = 0;
+        for (size_t i = k; i > 0; --i) {
+            if ((k - i) % 2 == 0)
+                rank += Detail::binomial(indices[i - 1] + 1, i);
+            else
+                rank -= Detail::binomial(indices[i - 1] + 1, i);
+        }
+        return rank - k % 2;
+    }
+
+    struct RevolvingDoorObject:
+    AlgorithmBase<RevolvingDoorObject> {
+        size_t num;
+        RevolvingDoorObject(size_t k): num(k) {}
+    };
+
+    class RevolvingDoorIterator:
+    public Detail::FlexibleIterator<RevolvingDoorIterator, const std::vector<size_t>> {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::vector<size_t>;
+        RevolvingDoorIterator() = default;
+        RevolvingDoorIterator(size_t n, size_t k, size_t rank):
+            n_(n), k_(k), rank_(rank), total_(Detail::binomial(n, k)) { seek(); }
+        const value_type& operator*() const noexcept { return indices_; }
+        value_type operator[](ptrdiff_t i) const { auto t = *this; t += i; return *t; }
+        RevolvingDoorIterator& operator++() {
+            if (++rank_ < total_)
+                step();
+            return *this;
+        }
+        RevolvingDoorIterator& operator--() { return *this += -1; }
+        RevolvingDoorIterator& operator+=(ptrdiff_t rhs) {
+            rank_ += rhs;
+            seek();
+            return *this;
+        }
+        ptrdiff_t operator-(const RevolvingDoorIterator& rhs) const noexcept { return ptrdiff_t(rank_ - rhs.rank_); }
+        bool operator==(const RevolvingDoorIterator& rhs) const noexcept { return rank_ == rhs.rank_; }
+        size_t rank() const noexcept { return rank_; }
+        size_t added() const noexcept { return added_; }
+        size_t removed() const noexcept { return removed_; }
+    private:
+        size_t n_ = 0;
+        size_t k_ = 0;
+        size_t rank_ = 0;
+        size_t total_ = 0;
+        size_t added_ = npos;
+        size_t removed_ = npos;
+        std::vector<size_t> indices_;
+        size_t& c(size_t j) noexcept { return indices_[j - 1]; }
+        size_t next_index(size_t j) const noexcept { return j < k_ ? indices_[j] : n_; }
+        void unrank(size_t r) {
+            indices_.resize(k_);
+            size_t x = n_;
+            for (size_t i = k_; i > 0; --i) {
+                while (Detail::binomial(x, i) > r)
+                    --x;
+                c(i) = x;
+                r = Detail::binomial(x + 1, i) - r - 1;
+            }
+        }
+        void seek() {
+            added_ = removed_ = npos;
+            if (rank_ >= total_)
+                return;
+            if (rank_ > 0) {
+                unrank(rank_ - 1);
+                auto prev = indices_;
+                unrank(rank_);
+                for (size_t i = 0, j = 0; i < k_ || j < k_;) {
+                    if (j == k_ || (i < k_ && prev[i] < indices_[j])) {
+                        removed_ = prev[i++];
+                    } else if (i == k_ || indices_[j] < prev[i]) {
+                        added_ = indices_[j++];
+                    } else {
+                        ++i;
+                        ++j;
+                    }
+                }
+            } else {
+                unrank(0);
+            }
+        }
+        // Knuth, TAOCP 7.2.1.3, Algorithm R
+        void step() {
+            if (k_ == 1) {
+                removed_ = c(1)++;
+                added_ = c(1);
+                return;
+            }
+            bool decrease;
+            if (k_ % 2 == 1) {
+                if (c(1) + 1 < c(2)) {
+                    removed_ = c(1)++;
+                    added_ = c(1);
+                    return;
+                }
+                decrease = true;
+            } else {
+                if (c(1) > 0) {
+                    removed_ = c(1)--;
+                    added_ = c(1);
+                    return;
+                }
+                decrease = false;
+            }
+            for (size_t j = 2;; ++j, decrease = true) {
+                if (decrease) {
+                    if (c(j) >= j) {
+                        removed_ = c(j);
+                        added_ = j - 2;
+                        c(j) = c(j - 1);
+                        c(j - 1) = j - 2;
+                        return;
+                    }
+                    ++j;
+                }
+                if (c(j) + 1 < next_index(j)) {
+                    removed_ = c(j - 1);
+                    added_ = c(j) + 1;
+                    c(j - 1) = c(j);
+                    ++c(j);
+                    return;
+                }
+            }
+        }
+    };
+
+    template <typename ForwardRange>
+    TL::Irange<RevolvingDoorIterator> operator>>(const ForwardRange& lhs, RevolvingDoorObject rhs) {
+        auto r = Detail::as_range(lhs);
+        size_t n = std::distance(r.begin(), r.end());
+        size_t total = Detail::binomial(n, rhs.num);
+        if (total > size_t(std::numeric_limits<ptrdiff_t>::max()))
+            throw std::length_error("revolving_door: too many combinations");
+        return {{n, rhs.num, 0}, {n, rhs.num, total}};
+    }
+
+    inline RevolvingDoorObject revolving_door(size_t k) { return {k}; }
+
     // subsets
 
     struct SubsetsObject:
@@ -2,9 +2,42 @@
 
 #include "rs-range/core.hpp"
 #include "rs-tl/iterator.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __cplusplus >= 202002L && __has_include(<coroutine>)
+    #include <coroutine>
+    #include <cstddef>
+    #include <new>
+    #define RS_RANGE_COROUTINES 1
+#endif
+
+#if __has_include(<unistd.h>)
+    #include <cerrno>
+    #include <system_error>
+    #include <unistd.h>
+    #define RS_RANGE_FILE_DESCRIPTORS 1
+    #if __has_include(<sys/mman.h>)
+        #include <fcntl.h>
+        #include <sys/mman.h>
+        #include <sys/stat.h>
+        #define RS_RANGE_MAPPED_FILES 1
+    #endif
+#endif
 
 namespace RS::Range {
 
@@ -21,6 +54,28 @@ namespace RS::Range {
 
     // fill, single
 
+    namespace Detail {
+
+        // A value whose bytes are all the same (including zero) can be
+        // written with memset; other trivially copyable values are left to
+        // fill_n, which the compiler turns into wide stores
+
+        template <typename T>
+        void fill_contiguous(T* out, size_t n, const T& t) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                unsigned char bytes[sizeof(T)];
+                std::memcpy(bytes, &t, sizeof(T));
+                if (std::all_of(bytes + 1, bytes + sizeof(T), [&] (unsigned char b) { return b == bytes[0]; })) {
+                    if (n != 0)
+                        std::memset(static_cast<void*>(out), bytes[0], n * sizeof(T));
+                    return;
+                }
+            }
+            std::fill_n(out, n, t);
+        }
+
+    }
+
     template <typename T>
     class FillIterator:
     public TL::RandomAccessIterator<FillIterator<T>, const T> {
@@ -28,10 +83,8 @@ namespace RS::Range {
         FillIterator() = default;
         FillIterator(const T& t, size_t n): value_(t), num_(n) {}
         const T& operator*() const noexcept { return value_; }
-        FillIterator& operator+=(ptrdiff_t rhs) noexcept
-            { if (rhs < 0) num_ += size_t(- rhs); else num_ -= size_t(rhs); return *this; }
-        ptrdiff_t operator-(const FillIterator& rhs) const noexcept
-            { return num_ <= rhs.num_ ? ptrdiff_t(rhs.num_ - num_) : - ptrdiff_t(num_ - rhs.num_); }
+        FillIterator& operator+=(ptrdiff_t rhs) noexcept { num_ -= size_t(rhs); return *this; }
+        ptrdiff_t operator-(const FillIterator& rhs) const noexcept { return ptrdiff_t(rhs.num_ - num_); }
     private:
         T value_;
         size_t num_ = 0;
@@ -39,9 +92,14 @@ namespace RS::Range {
 
     template <typename Range, typename T>
     Range& operator<<(Range& lhs, const TL::Irange<FillIterator<T>>& rhs) {
-        auto i = rhs.begin();
-        for (auto& x: lhs)
-            x = *i++;
+        auto b = std::begin(lhs), e = std::end(lhs);
+        if constexpr (Detail::is_contiguous_iterator<TL::RangeIterator<Range>>
+                && std::is_same_v<TL::RangeValue<Range>, T>) {
+            if (b != e)
+                Detail::fill_contiguous(&*b, size_t(e - b), *rhs.begin());
+        } else {
+            std::fill(b, e, *rhs.begin());
+        }
         return lhs;
     }
 
@@ -68,6 +126,7 @@ namespace RS::Range {
         const value_type& operator*() const noexcept { if (! ok_) { value = fun_(); ok_ = true; } return value; }
         GenerateIterator& operator++() { --num_; ok_ = false; return *this; }
         bool operator==(const GenerateIterator& rhs) const noexcept { return num_ == rhs.num_; }
+        const function_type& function() const noexcept { return fun_; }
     private:
         function_type fun_;
         size_t num_ = 0;
@@ -77,9 +136,20 @@ namespace RS::Range {
 
     template <typename Range, typename Function>
     Range& operator<<(Range& lhs, const TL::Irange<GenerateIterator<Function>>& rhs) {
-        auto i = rhs.begin();
-        for (auto& x: lhs)
-            x = *i++;
+        // Call the function straight into the target, bypassing the
+        // iterator's cached value
+        auto f = rhs.begin().function();
+        auto b = std::begin(lhs), e = std::end(lhs);
+        if constexpr (Detail::is_contiguous_iterator<TL::RangeIterator<Range>>) {
+            if (b != e) {
+                auto out = &*b;
+                for (size_t i = 0, n = size_t(e - b); i < n; ++i)
+                    out[i] = f();
+            }
+        } else {
+            for (; b != e; ++b)
+                *b = f();
+        }
         return lhs;
     }
 
@@ -88,6 +158,184 @@ namespace RS::Range {
         return {{f, n}, {}};
     }
 
+    // generator
+
+    #ifdef RS_RANGE_COROUTINES
+
+        template <typename T, typename Allocator = std::allocator<std::byte>> class Generator;
+
+        template <typename T, typename Allocator>
+        struct ElementsOf {
+            Generator<T, Allocator>& gen;
+        };
+
+        template <typename T, typename Allocator>
+        inline ElementsOf<T, Allocator> elements_of(Generator<T, Allocator>&& g) noexcept {
+            return {g};
+        }
+
+        template <typename T, typename Allocator>
+        class Generator {
+
+        public:
+
+            class promise_type;
+
+            using handle_type = std::coroutine_handle<promise_type>;
+
+            class iterator:
+            public TL::InputIterator<iterator, const T> {
+            public:
+                iterator() = default;
+                explicit iterator(handle_type h) noexcept: handle_(h) {}
+                const T& operator*() const noexcept { return *handle_.promise().value_; }
+                iterator& operator++() { handle_.promise().leaf_->handle().resume(); return *this; }
+                bool operator==(const iterator& rhs) const noexcept { return done() == rhs.done(); }
+            private:
+                handle_type handle_;
+                bool done() const noexcept { return ! handle_ || handle_.done(); }
+            };
+
+            class promise_type {
+
+            public:
+
+                Generator get_return_object() noexcept { return Generator(handle()); }
+                std::suspend_always initial_suspend() const noexcept { return {}; }
+                auto final_suspend() const noexcept { return final_awaiter(); }
+                std::suspend_always yield_value(const T& t) noexcept { root_->value_ = std::addressof(t); return {}; }
+                auto yield_value(ElementsOf<T, Allocator> e) noexcept { return nested_awaiter{e.gen.handle_}; }
+                void return_void() const noexcept {}
+                void unhandled_exception() { throw; }
+
+                // The frame is allocated through Allocator, with a copy of
+                // the allocator stored after it; a stateful allocator is
+                // passed as a coroutine argument after std::allocator_arg
+
+                static void* operator new(size_t n) requires std::is_default_constructible_v<Allocator> {
+                    return allocate(Allocator(), n);
+                }
+
+                template <typename... Args>
+                static void* operator new(size_t n, std::allocator_arg_t, const Allocator& alloc, const Args&...) {
+                    return allocate(alloc, n);
+                }
+
+                template <typename Class, typename... Args>
+                static void* operator new(size_t n, const Class&, std::allocator_arg_t, const Allocator& alloc, const Args&...) {
+                    return allocate(alloc, n);
+                }
+
+                static void operator delete(void* ptr, size_t n) noexcept {
+                    auto ap = std::launder(reinterpret_cast<block_allocator*>(static_cast<unsigned char*>(ptr) + allocator_offset(n)));
+                    block_allocator alloc(std::move(*ap));
+                    ap->~block_allocator();
+                    alloc.deallocate(static_cast<block*>(ptr), block_count(n));
+                }
+
+            private:
+
+                friend class Generator;
+                friend class iterator;
+
+                struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) block {
+                    unsigned char bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+                };
+
+                using block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<block>;
+
+                static_assert(alignof(block_allocator) <= alignof(block));
+
+                // Entering a nested generator and leaving it at its final
+                // suspend point both transfer control directly to the other
+                // coroutine, so nesting depth costs no stack
+
+                struct nested_awaiter {
+                    handle_type child;
+                    bool await_ready() const noexcept { return ! child; }
+                    std::coroutine_handle<> await_suspend(handle_type h) noexcept {
+                        auto& parent = h.promise();
+                        auto& inner = child.promise();
+                        inner.root_ = parent.root_;
+                        inner.parent_ = &parent;
+                        parent.root_->leaf_ = &inner;
+                        return child;
+                    }
+                    void await_resume() const noexcept {}
+                };
+
+                struct final_awaiter {
+                    bool await_ready() const noexcept { return false; }
+                    std::coroutine_handle<> await_suspend(handle_type h) noexcept {
+                        auto& p = h.promise();
+                        if (! p.parent_)
+                            return std::noop_coroutine();
+                        p.root_->leaf_ = p.parent_;
+                        return p.parent_->handle();
+                    }
+                    void await_resume() const noexcept {}
+                };
+
+                const T* value_ = nullptr;
+                promise_type* root_ = this;
+                promise_type* parent_ = nullptr;
+                promise_type* leaf_ = this;
+
+                handle_type handle() noexcept { return handle_type::from_promise(*this); }
+
+                static size_t allocator_offset(size_t n) noexcept {
+                    return (n + alignof(block_allocator) - 1) / alignof(block_allocator) * alignof(block_allocator);
+                }
+
+                static size_t block_count(size_t n) noexcept {
+                    return (allocator_offset(n) + sizeof(block_allocator) + sizeof(block) - 1) / sizeof(block);
+                }
+
+                static void* allocate(const Allocator& a, size_t n) {
+                    block_allocator alloc(a);
+                    void* ptr = alloc.allocate(block_count(n));
+                    new (static_cast<unsigned char*>(ptr) + allocator_offset(n)) block_allocator(std::move(alloc));
+                    return ptr;
+                }
+
+            };
+
+            Generator() = default;
+            ~Generator() noexcept { if (handle_) handle_.destroy(); }
+            Generator(const Generator&) = delete;
+            Generator(Generator&& g) noexcept:
+                handle_(std::exchange(g.handle_, nullptr)), started_(std::exchange(g.started_, false)) {}
+            Generator& operator=(const Generator&) = delete;
+            Generator& operator=(Generator&& g) noexcept {
+                std::swap(handle_, g.handle_);
+                std::swap(started_, g.started_);
+                return *this;
+            }
+
+            // Only the first call starts the coroutine; later calls return an
+            // iterator at its current position, never resuming a finished frame
+            iterator begin() const {
+                if (handle_ && ! started_ && ! handle_.done()) {
+                    started_ = true;
+                    handle_.resume();
+                }
+                return iterator(handle_);
+            }
+            iterator end() const noexcept { return {}; }
+
+        private:
+
+            template <typename T2, typename A2> friend class Generator;
+
+            handle_type handle_;
+            mutable bool started_ = false;
+
+            explicit Generator(handle_type h) noexcept: handle_(h) {}
+
+        };
+
+    #endif
+
     // iota
 
     template <typename T>
@@ -114,23 +362,767 @@ namespace RS::Range {
         return lhs;
     }
 
+    // Arithmetic progressions are computed directly from the index, so
+    // jumps are constant time and no callable is stored
+
+    namespace Detail {
+
+        template <typename T> constexpr bool is_arithmetic_iota = std::is_arithmetic_v<T> && ! std::is_same_v<T, bool>;
+
+        // Integer progressions wrap modulo 2^64 instead of overflowing
+
+        template <typename T>
+        T iota_value(T init, T delta, size_t i) noexcept {
+            if constexpr (std::is_integral_v<T>)
+                return T(uint64_t(init) + uint64_t(i) * uint64_t(delta));
+            else
+                return T(init + T(i) * delta);
+        }
+
+    }
+
+    template <typename T>
+    class ArithmeticIotaIterator:
+    public TL::RandomAccessIterator<ArithmeticIotaIterator<T>, const T> {
+    public:
+        ArithmeticIotaIterator() = default;
+        ArithmeticIotaIterator(const T& init, const T& delta, size_t i):
+            init_(init), delta_(delta), index_(i), value_(at(i)) {}
+        const T& operator*() const noexcept { return value_; }
+        ArithmeticIotaIterator& operator+=(ptrdiff_t rhs) noexcept { index_ += size_t(rhs); value_ = at(index_); return *this; }
+        ptrdiff_t operator-(const ArithmeticIotaIterator& rhs) const noexcept {
+            // Saturate, since an unbounded iota ends at index npos
+            constexpr auto limit = size_t(std::numeric_limits<ptrdiff_t>::max());
+            if (index_ >= rhs.index_)
+                return ptrdiff_t(std::min(index_ - rhs.index_, limit));
+            else
+                return - ptrdiff_t(std::min(rhs.index_ - index_, limit));
+        }
+        T operator[](ptrdiff_t i) const noexcept { return at(index_ + size_t(i)); }
+        T init() const noexcept { return init_; }
+        T delta() const noexcept { return delta_; }
+        size_t index() const noexcept { return index_; }
+    private:
+        T init_ = T();
+        T delta_ = T();
+        size_t index_ = 0;
+        T value_ = T();
+        T at(size_t i) const noexcept { return Detail::iota_value(init_, delta_, i); }
+    };
+
+    template <typename Range, typename T>
+    Range& operator<<(Range& lhs, const TL::Irange<ArithmeticIotaIterator<T>>& rhs) {
+        T init = rhs.begin().init(), delta = rhs.begin().delta();
+        size_t i = rhs.begin().index();
+        for (auto& x: lhs)
+            x = Detail::iota_value(init, delta, i++);
+        return lhs;
+    }
+
     template <typename T, typename UnaryFunction>
     inline TL::Irange<IotaIterator<T>> iota(const T& init, UnaryFunction f, size_t n = npos) {
         return {{init, f, n}, {}};
     }
 
     template <typename T>
-    inline auto iota(const T& init) {
-        return iota(init, [] (T t) { return T(++t); });
+    inline auto iota(const T& init, const T& delta, size_t n = npos) {
+        if constexpr (Detail::is_arithmetic_iota<T>)
+            return TL::Irange<ArithmeticIotaIterator<T>>{{init, delta, 0}, {init, delta, n}};
+        else
+            return iota(init, [delta] (const T& t) { return T(t + delta); }, n);
     }
 
     template <typename T>
-    inline auto iota(const T& init, const T& delta, size_t n = npos) {
-        return iota(init, [delta] (const T& t) { return T(t + delta); }, n);
+    inline auto iota(const T& init) {
+        if constexpr (Detail::is_arithmetic_iota<T>)
+            return iota(init, T(1));
+        else
+            return iota(init, [] (T t) { return T(++t); });
+    }
+
+    // lines
+
+    namespace Detail {
+
+        // Reads a stream through a buffer that grows to hold the longest
+        // line; a line is returned as a view into the buffer, which stays
+        // valid until the next line is read
+
+        class LineReader {
+        public:
+            using read_function = std::function<size_t(char*, size_t)>;
+            LineReader(read_function f, size_t capacity): read_(f), buffer_(std::max(capacity, size_t(1))) {}
+            bool next(std::string_view& line) {
+                for (;;) {
+                    auto data = buffer_.data();
+                    auto nl = static_cast<const char*>(std::memchr(data + scan_, '\n', end_ - scan_));
+                    if (nl) {
+                        auto e = nl;
+                        if (e != data + pos_ && e[-1] == '\r')
+                            --e;
+                        line = std::string_view(data + pos_, size_t(e - data) - pos_);
+                        pos_ = scan_ = size_t(nl - data) + 1;
+                        return true;
+                    }
+                    scan_ = end_;
+                    if (eof_) {
+                        if (pos_ == end_)
+                            return false;
+                        line = std::string_view(data + pos_, end_ - pos_);
+                        pos_ = end_;
+                        return true;
+                    }
+                    refill();
+                }
+            }
+        private:
+            read_function read_;
+            std::vector<char> buffer_;
+            size_t pos_ = 0;
+            size_t scan_ = 0;
+            size_t end_ = 0;
+            bool eof_ = false;
+            void refill() {
+                if (pos_ > 0) {
+                    std::memmove(buffer_.data(), buffer_.data() + pos_, end_ - pos_);
+                    end_ -= pos_;
+                    scan_ -= pos_;
+                    pos_ = 0;
+                }
+                if (end_ == buffer_.size())
+                    buffer_.resize(2 * buffer_.size());
+                size_t n = read_(buffer_.data() + end_, buffer_.size() - end_);
+                if (n == 0)
+                    eof_ = true;
+                else
+                    end_ += n;
+            }
+        };
+
+    }
+
+    class LineIterator:
+    public TL::ForwardIterator<LineIterator, const std::string_view> {
+    public:
+        LineIterator() = default;
+        LineIterator(const char* b, const char* e):
+            begin_(b != e ? b : nullptr), end_(e) { if (begin_) next(b); }
+        const std::string_view& operator*() const noexcept { return value_; }
+        LineIterator& operator++() {
+            if (next_ == end_)
+                begin_ = nullptr;
+            else
+                next(next_);
+            return *this;
+        }
+        bool operator==(const LineIterator& rhs) const noexcept { return begin_ == rhs.begin_; }
+    private:
+        const char* begin_ = nullptr;
+        const char* end_ = nullptr;
+        const char* next_ = nullptr;
+        std::string_view value_;
+        void next(const char* p) {
+            begin_ = p;
+            auto nl = static_cast<const char*>(std::memchr(p, '\n', size_t(end_ - p)));
+            if (nl) {
+                next_ = nl + 1;
+                if (nl != p && nl[-1] == '\r')
+                    --nl;
+            } else {
+                next_ = nl = end_;
+            }
+            value_ = std::string_view(p, size_t(nl - p));
+        }
+    };
+
+    class LineReaderIterator:
+    public TL::InputIterator<LineReaderIterator, const std::string_view> {
+    public:
+        LineReaderIterator() = default;
+        explicit LineReaderIterator(std::shared_ptr<Detail::LineReader> r): reader_(r) { ++*this; }
+        const std::string_view& operator*() const noexcept { return value_; }
+        LineReaderIterator& operator++() { if (! reader_->next(value_)) reader_.reset(); return *this; }
+        bool operator==(const LineReaderIterator& rhs) const noexcept { return reader_ == rhs.reader_; }
+    private:
+        std::shared_ptr<Detail::LineReader> reader_;
+        std::string_view value_;
+    };
+
+    constexpr size_t default_line_buffer = 65536;
+
+    inline TL::Irange<LineIterator> lines(std::string_view text) {
+        return {{text.data(), text.data() + text.size()}, {}};
+    }
+
+    inline TL::Irange<LineReaderIterator> lines(std::istream& in, size_t buffer_size = default_line_buffer) {
+        auto read = [&in] (char* ptr, size_t n) {
+            auto buf = in.rdbuf();
+            return buf ? size_t(buf->sgetn(ptr, std::streamsize(n))) : size_t(0);
+        };
+        return {LineReaderIterator(std::make_shared<Detail::LineReader>(read, buffer_size)), {}};
     }
 
+    #ifdef RS_RANGE_FILE_DESCRIPTORS
+
+        inline TL::Irange<LineReaderIterator> lines(int fd, size_t buffer_size = default_line_buffer) {
+            auto read = [fd] (char* ptr, size_t n) {
+                for (;;) {
+                    auto rc = ::read(fd, ptr, n);
+                    if (rc >= 0)
+                        return size_t(rc);
+                    if (errno != EINTR)
+                        throw std::system_error(errno, std::generic_category(), "read()");
+                }
+            };
+            return {LineReaderIterator(std::make_shared<Detail::LineReader>(read, buffer_size)), {}};
+        }
+
+    #endif
+
+    // mapped_range
+
+    #ifdef RS_RANGE_MAPPED_FILES
+
+        namespace MapHint {
+
+            constexpr int normal = 0;
+            constexpr int sequential = 1;
+            constexpr int random = 2;
+            constexpr int willneed = 4;
+            constexpr int huge_pages = 8;
+
+        }
+
+        namespace Detail {
+
+            class FileMapping {
+            public:
+                FileMapping(const std::string& path, int hints) {
+                    int fd = ::open(path.c_str(), O_RDONLY);
+                    if (fd == -1)
+                        throw std::system_error(errno, std::generic_category(), path);
+                    struct stat info;
+                    if (::fstat(fd, &info) == -1) {
+                        int err = errno;
+                        ::close(fd);
+                        throw std::system_error(err, std::generic_category(), path);
+                    }
+                    size_ = size_t(info.st_size);
+                    if (size_ != 0) {
+                        void* ptr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+                        if (ptr == MAP_FAILED) {
+                            int err = errno;
+                            ::close(fd);
+                            throw std::system_error(err, std::generic_category(), path);
+                        }
+                        data_ = ptr;
+                        advise(hints);
+                    }
+                    ::close(fd);
+                }
+                ~FileMapping() noexcept { if (data_) ::munmap(data_, size_); }
+                FileMapping(const FileMapping&) = delete;
+                FileMapping& operator=(const FileMapping&) = delete;
+                const void* data() const noexcept { return data_; }
+                size_t size() const noexcept { return size_; }
+            private:
+                void* data_ = nullptr;
+                size_t size_ = 0;
+                // Hints are advisory; failure only loses the optimisation
+                void advise(int hints) noexcept {
+                    if (hints & MapHint::sequential)
+                        ::posix_madvise(data_, size_, POSIX_MADV_SEQUENTIAL);
+                    else if (hints & MapHint::random)
+                        ::posix_madvise(data_, size_, POSIX_MADV_RANDOM);
+                    if (hints & MapHint::willneed)
+                        ::posix_madvise(data_, size_, POSIX_MADV_WILLNEED);
+                    #ifdef MADV_HUGEPAGE
+                        if (hints & MapHint::huge_pages)
+                            ::madvise(data_, size_, MADV_HUGEPAGE);
+                    #endif
+                }
+            };
+
+        }
+
+        template <typename T>
+        Detail::MappedRange<T> mapped_range(const std::string& path, int hints = MapHint::normal) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            auto map = std::make_shared<Detail::FileMapping>(path, hints);
+            Detail::MappedIterator<T> i, j;
+            i.ptr = static_cast<const T*>(map->data());
+            j.ptr = i.ptr + map->size() / sizeof(T);
+            i.share = j.share = map;
+            return {i, j};
+        }
+
+    #endif
+
     // random
 
+    // Four interleaved xoshiro256++ generators (Blackman & Vigna), stepped
+    // in lockstep so that a block of four outputs is one vectorisable pass;
+    // the lanes are seeded from consecutive splitmix64 outputs
+
+    class Xoshiro256x4 {
+    public:
+        using result_type = uint64_t;
+        static constexpr size_t lanes = 4;
+        Xoshiro256x4() noexcept { seed(0); }
+        explicit Xoshiro256x4(uint64_t s) noexcept { seed(s); }
+        result_type operator()() noexcept {
+            if (pos_ == buffer_size) {
+                generate(buffer_, buffer_size / lanes);
+                pos_ = 0;
+            }
+            return buffer_[pos_++];
+        }
+        void fill(uint64_t* out, size_t n) noexcept {
+            for (; n > 0 && pos_ < buffer_size; --n)
+                *out++ = buffer_[pos_++];
+            size_t steps = n / lanes;
+            generate(out, steps);
+            out += steps * lanes;
+            n -= steps * lanes;
+            for (; n > 0; --n)
+                *out++ = (*this)();
+        }
+        void seed(uint64_t s) noexcept {
+            for (auto state: {s0_, s1_, s2_, s3_}) {
+                for (size_t k = 0; k < lanes; ++k) {
+                    uint64_t z = s += 0x9e3779b97f4a7c15ull;
+                    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                    state[k] = z ^ (z >> 31);
+                }
+            }
+            pos_ = buffer_size;
+        }
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+    private:
+        static constexpr size_t buffer_size = 16 * lanes;
+        uint64_t s0_[lanes], s1_[lanes], s2_[lanes], s3_[lanes];
+        uint64_t buffer_[buffer_size];
+        size_t pos_ = buffer_size;
+        static constexpr uint64_t rotl(uint64_t x, int k) noexcept { return (x << k) | (x >> (64 - k)); }
+        void generate(uint64_t* out, size_t steps) noexcept {
+            uint64_t s0[lanes], s1[lanes], s2[lanes], s3[lanes];
+            std::memcpy(s0, s0_, sizeof(s0));
+            std::memcpy(s1, s1_, sizeof(s1));
+            std::memcpy(s2, s2_, sizeof(s2));
+            std::memcpy(s3, s3_, sizeof(s3));
+            for (size_t j = 0; j < steps; ++j, out += lanes) {
+                for (size_t k = 0; k < lanes; ++k) {
+                    out[k] = rotl(s0[k] + s3[k], 23) + s0[k];
+                    uint64_t t = s1[k] << 17;
+                    s2[k] ^= s0[k];
+                    s3[k] ^= s1[k];
+                    s1[k] ^= s2[k];
+                    s0[k] ^= s3[k];
+                    s2[k] ^= t;
+                    s3[k] = rotl(s3[k], 45);
+                }
+            }
+            std::memcpy(s0_, s0, sizeof(s0));
+            std::memcpy(s1_, s1, sizeof(s1));
+            std::memcpy(s2_, s2, sizeof(s2));
+            std::memcpy(s3_, s3, sizeof(s3));
+        }
+    };
+
+    namespace Detail {
+
+        template <typename RandomEngine, typename = void> struct HasBlockFill: std::false_type {};
+        template <typename RandomEngine>
+            struct HasBlockFill<RandomEngine, std::void_t<decltype(std::declval<RandomEngine&>().fill(std::declval<uint64_t*>(), size_t()))>>:
+            std::true_type {};
+        template <typename RandomEngine> constexpr bool has_block_fill = HasBlockFill<RandomEngine>::value;
+
+        template <typename RandomDistributon, typename RandomEngine, typename = void> struct HasBatchGenerate: std::false_type {};
+        template <typename RandomDistributon, typename RandomEngine>
+            struct HasBatchGenerate<RandomDistributon, RandomEngine, std::void_t<decltype(std::declval<RandomDistributon&>().generate(
+                std::declval<RandomEngine&>(), std::declval<typename RandomDistributon::result_type*>(), size_t()))>>:
+            std::true_type {};
+        template <typename RandomDistributon, typename RandomEngine> constexpr bool has_batch_generate =
+            HasBatchGenerate<RandomDistributon, RandomEngine>::value;
+
+        // 64 random bits from any standard engine
+
+        template <typename RandomEngine>
+        uint64_t random_bits(RandomEngine& rng) {
+            using R = typename RandomEngine::result_type;
+            if constexpr (RandomEngine::min() == 0 && uint64_t(RandomEngine::max()) == ~ uint64_t(0))
+                return rng();
+            else if constexpr (RandomEngine::min() == 0 && uint64_t(RandomEngine::max()) == 0xffffffffull && sizeof(R) >= 4)
+                return (uint64_t(rng()) << 32) | uint64_t(rng());
+            else
+                return std::uniform_int_distribution<uint64_t>()(rng);
+        }
+
+        template <typename RandomEngine>
+        void random_block(RandomEngine& rng, uint64_t* out, size_t n) {
+            if constexpr (has_block_fill<RandomEngine>)
+                rng.fill(out, n);
+            else
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = random_bits(rng);
+        }
+
+        // Batch kernels draw raw bits a block at a time into a local buffer
+        // and transform them in straight line loops
+
+        constexpr size_t random_block_size = 256;
+
+        inline uint64_t mul_high(uint64_t x, uint64_t y, uint64_t& low) noexcept {
+            #ifdef __SIZEOF_INT128__
+                __extension__ using uint128 = unsigned __int128;
+                auto m = uint128(x) * y;
+                low = uint64_t(m);
+                return uint64_t(m >> 64);
+            #else
+                uint64_t x0 = x & 0xffffffffull, x1 = x >> 32, y0 = y & 0xffffffffull, y1 = y >> 32;
+                uint64_t p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+                uint64_t mid = (p00 >> 32) + (p01 & 0xffffffffull) + (p10 & 0xffffffffull);
+                low = x * y;
+                return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+            #endif
+        }
+
+        // Uniform integer in [0,range) (Lemire, "Fast random integer
+        // generation in an interval"); range must be nonzero
+
+        template <typename RandomEngine>
+        uint64_t uniform_index(RandomEngine& rng, uint64_t range) {
+            uint64_t low = 0;
+            uint64_t high = mul_high(random_bits(rng), range, low);
+            if (low < range) {
+                uint64_t threshold = (0 - range) % range;
+                while (low < threshold)
+                    high = mul_high(random_bits(rng), range, low);
+            }
+            return high;
+        }
+
+        // Ziggurat tables for the standard normal distribution (Doornik,
+        // "An improved ziggurat method to generate normal random samples")
+
+        struct ZigguratTables {
+            static constexpr int layers = 128;
+            static constexpr double r = 3.442619855899;
+            static constexpr double v = 9.91256303526217e-3;
+            double x[layers + 1];
+            double ratio[layers];
+            ZigguratTables() noexcept {
+                double f = std::exp(-0.5 * r * r);
+                x[0] = v / f;
+                x[1] = r;
+                x[layers] = 0;
+                for (int i = 2; i < layers; ++i) {
+                    x[i] = std::sqrt(-2 * std::log(v / x[i - 1] + f));
+                    f = std::exp(-0.5 * x[i] * x[i]);
+                }
+                for (int i = 0; i < layers; ++i)
+                    ratio[i] = x[i + 1] / x[i];
+            }
+        };
+
+        inline const ZigguratTables& ziggurat_tables() noexcept {
+            static const ZigguratTables tables;
+            return tables;
+        }
+
+        // Uses the top 52 bits as the mantissa of a double in [1,2); a bit
+        // pattern conversion vectorises where an integer conversion does not
+
+        inline double unit_real(uint64_t bits) noexcept {
+            uint64_t pattern = (bits >> 12) | 0x3ff0000000000000ull;
+            double x;
+            std::memcpy(&x, &pattern, sizeof(x));
+            return x - 1;
+        }
+
+        // Float needs its own pattern: rounding a 52 bit double in [0,1) to
+        // float can give exactly 1
+
+        template <typename T>
+        T unit_real_as(uint64_t bits) noexcept {
+            if constexpr (std::is_same_v<T, float>) {
+                uint32_t pattern = uint32_t(bits >> 41) | 0x3f800000u;
+                float x;
+                std::memcpy(&x, &pattern, sizeof(x));
+                return x - 1;
+            } else {
+                return T(unit_real(bits));
+            }
+        }
+
+        template <typename RandomEngine>
+        double ziggurat_slow(RandomEngine& rng, uint64_t bits) {
+            auto& z = ziggurat_tables();
+            for (;;) {
+                double u = 2 * unit_real(bits) - 1;
+                size_t i = bits % ZigguratTables::layers;
+                if (std::abs(u) < z.ratio[i])
+                    return u * z.x[i];
+                if (i == 0) {
+                    double x, y;
+                    do {
+                        x = std::log(unit_real(random_bits(rng)) + 0x1.0p-54) / ZigguratTables::r;
+                        y = std::log(unit_real(random_bits(rng)) + 0x1.0p-54);
+                    } while (-2 * y < x * x);
+                    return u < 0 ? x - ZigguratTables::r : ZigguratTables::r - x;
+                }
+                double x = u * z.x[i];
+                double f0 = std::exp(-0.5 * (z.x[i] * z.x[i] - x * x));
+                double f1 = std::exp(-0.5 * (z.x[i + 1] * z.x[i + 1] - x * x));
+                if (f1 + unit_real(random_bits(rng)) * (f0 - f1) < 1)
+                    return x;
+                bits = random_bits(rng);
+            }
+        }
+
+    }
+
+    // Distributions with batch kernels; each can be used one value at a
+    // time like the standard distributions, or through generate() to fill
+    // a buffer, which random() and the sampling algorithms use when they can
+
+    template <typename T>
+    class UniformIntDistribution {
+    public:
+        static_assert(std::is_integral_v<T> && ! std::is_same_v<T, bool>);
+        using result_type = T;
+        UniformIntDistribution() noexcept: UniformIntDistribution(0, std::numeric_limits<T>::max()) {}
+        UniformIntDistribution(T a, T b) noexcept: a_(a), b_(b), range_(uint64_t(b) - uint64_t(a) + 1) {}
+        template <typename RandomEngine> T operator()(RandomEngine& rng) const {
+            if (range_ == 0)
+                return T(Detail::random_bits(rng));
+            else
+                return T(uint64_t(a_) + Detail::uniform_index(rng, range_));
+        }
+        template <typename RandomEngine> void generate(RandomEngine& rng, T* out, size_t n) const {
+            uint64_t buffer[Detail::random_block_size];
+            if (range_ == 0 || range_ > 0xffffffffull) {
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = (*this)(rng);
+                return;
+            }
+            // Two 32-bit samples per word; a rejected sample is rare, and
+            // is replaced by a scalar draw after the vector pass
+            uint64_t range = range_;
+            uint32_t threshold = uint32_t(0 - range) % uint32_t(range);
+            uint64_t base = uint64_t(a_);
+            while (n > 1) {
+                size_t words = std::min(Detail::random_block_size, n / 2);
+                Detail::random_block(rng, buffer, words);
+                uint32_t reject = 0;
+                for (size_t i = 0; i < words; ++i) {
+                    uint64_t p = (buffer[i] & 0xffffffffull) * range;
+                    uint64_t q = (buffer[i] >> 32) * range;
+                    out[2 * i] = T(base + (p >> 32));
+                    out[2 * i + 1] = T(base + (q >> 32));
+                    reject |= uint32_t(uint32_t(p) < threshold) | uint32_t(uint32_t(q) < threshold);
+                }
+                if (reject) {
+                    for (size_t i = 0; i < words; ++i) {
+                        if (uint32_t((buffer[i] & 0xffffffffull) * range) < threshold)
+                            out[2 * i] = (*this)(rng);
+                        if (uint32_t((buffer[i] >> 32) * range) < threshold)
+                            out[2 * i + 1] = (*this)(rng);
+                    }
+                }
+                out += 2 * words;
+                n -= 2 * words;
+            }
+            if (n == 1)
+                *out = (*this)(rng);
+        }
+        T a() const noexcept { return a_; }
+        T b() const noexcept { return b_; }
+        T min() const noexcept { return a_; }
+        T max() const noexcept { return b_; }
+    private:
+        T a_;
+        T b_;
+        uint64_t range_;
+    };
+
+    template <typename T>
+    class UniformRealDistribution {
+    public:
+        static_assert(std::is_floating_point_v<T>);
+        using result_type = T;
+        UniformRealDistribution() noexcept: UniformRealDistribution(0, 1) {}
+        UniformRealDistribution(T a, T b) noexcept: a_(a), b_(b), last_(std::nextafter(b, a)) {}
+        template <typename RandomEngine> T operator()(RandomEngine& rng) const {
+            T x = a_ + (b_ - a_) * Detail::unit_real_as<T>(Detail::random_bits(rng));
+            return x == b_ ? last_ : x;
+        }
+        template <typename RandomEngine> void generate(RandomEngine& rng, T* out, size_t n) const {
+            uint64_t buffer[Detail::random_block_size];
+            T base = a_, scale = b_ - a_, b = b_, last = last_;
+            while (n > 0) {
+                size_t m = std::min(Detail::random_block_size, n);
+                Detail::random_block(rng, buffer, m);
+                for (size_t i = 0; i < m; ++i) {
+                    // Rounding in the scaling step can still land on b
+                    T x = base + scale * Detail::unit_real_as<T>(buffer[i]);
+                    out[i] = x == b ? last : x;
+                }
+                out += m;
+                n -= m;
+            }
+        }
+        T a() const noexcept { return a_; }
+        T b() const noexcept { return b_; }
+        T min() const noexcept { return a_; }
+        T max() const noexcept { return b_; }
+    private:
+        T a_;
+        T b_;
+        T last_;
+    };
+
+    template <typename T>
+    class NormalDistribution {
+    public:
+        static_assert(std::is_floating_point_v<T>);
+        using result_type = T;
+        NormalDistribution() noexcept: NormalDistribution(0, 1) {}
+        NormalDistribution(T mean, T sd) noexcept: mean_(mean), sd_(sd) {}
+        template <typename RandomEngine> T operator()(RandomEngine& rng) const {
+            return mean_ + sd_ * T(Detail::ziggurat_slow(rng, Detail::random_bits(rng)));
+        }
+        template <typename RandomEngine> void generate(RandomEngine& rng, T* out, size_t n) const {
+            // The rectangle test accepts about 98.8% of samples; the vector
+            // pass takes those, and rejects are finished one by one. Values
+            // go through a local block so that the table lookups cannot
+            // alias the output.
+            using Z = Detail::ZigguratTables;
+            auto& z = Detail::ziggurat_tables();
+            uint64_t buffer[Detail::random_block_size];
+            T block[Detail::random_block_size];
+            T mean = mean_, sd = sd_;
+            while (n > 0) {
+                size_t m = std::min(Detail::random_block_size, n);
+                Detail::random_block(rng, buffer, m);
+                uint64_t reject = 0;
+                for (size_t i = 0; i < m; ++i) {
+                    double u = 2 * Detail::unit_real(buffer[i]) - 1;
+                    size_t k = buffer[i] % Z::layers;
+                    block[i] = mean + sd * T(u * z.x[k]);
+                    reject |= uint64_t(! (std::abs(u) < z.ratio[k]));
+                }
+                if (reject) {
+                    for (size_t i = 0; i < m; ++i) {
+                        double u = 2 * Detail::unit_real(buffer[i]) - 1;
+                        size_t k = buffer[i] % Z::layers;
+                        if (! (std::abs(u) < z.ratio[k]))
+                            block[i] = mean + sd * T(Detail::ziggurat_slow(rng, buffer[i]));
+                    }
+                }
+                std::copy(block, block + m, out);
+                out += m;
+                n -= m;
+            }
+        }
+        T mean() const noexcept { return mean_; }
+        T stddev() const noexcept { return sd_; }
+    private:
+        T mean_;
+        T sd_;
+    };
+
+    class BernoulliDistribution {
+    public:
+        using result_type = bool;
+        BernoulliDistribution() noexcept: BernoulliDistribution(0.5) {}
+        explicit BernoulliDistribution(double p) noexcept: p_(p) {
+            // A half takes one bit per sample, and other multiples of 1/256
+            // take one byte
+            if (p == 0.5)
+                bits_ = 1;
+            else if (std::ldexp(p, 8) == std::floor(std::ldexp(p, 8)))
+                bits_ = 8;
+            else
+                bits_ = 64;
+            if (p >= 1)
+                threshold_ = ~ uint64_t(0);
+            else if (p <= 0)
+                threshold_ = 0;
+            else if (bits_ < 64)
+                threshold_ = uint64_t(std::ldexp(p, bits_));
+            else
+                threshold_ = uint64_t(std::ldexp(p, 64));
+        }
+        template <typename RandomEngine> bool operator()(RandomEngine& rng) const {
+            if (p_ >= 1)
+                return true;
+            uint64_t bits = Detail::random_bits(rng);
+            if (bits_ < 64)
+                bits >>= 64 - bits_;
+            return bits < threshold_;
+        }
+        template <typename RandomEngine> void generate(RandomEngine& rng, bool* out, size_t n) const {
+            uint64_t buffer[Detail::random_block_size];
+            if (p_ >= 1 || p_ <= 0) {
+                std::fill(out, out + n, p_ >= 1);
+                return;
+            }
+            size_t per_word = 64 / bits_;
+            uint64_t threshold = threshold_;
+            while (n > 0) {
+                size_t words = std::min(Detail::random_block_size, (n + per_word - 1) / per_word);
+                size_t m = std::min(n, words * per_word);
+                Detail::random_block(rng, buffer, words);
+                if (bits_ == 1) {
+                    for (size_t i = 0; i < m; ++i)
+                        out[i] = (buffer[i / 64] >> (i % 64)) & 1;
+                } else if (bits_ == 8) {
+                    auto bytes = reinterpret_cast<const unsigned char*>(buffer);
+                    for (size_t i = 0; i < m; ++i)
+                        out[i] = bytes[i] < threshold;
+                } else {
+                    for (size_t i = 0; i < m; ++i)
+                        out[i] = buffer[i] < threshold;
+                }
+                out += m;
+                n -= m;
+            }
+        }
+        double p() const noexcept { return p_; }
+    private:
+        double p_;
+        int bits_;
+        uint64_t threshold_;
+    };
+
+    namespace Detail {
+
+        // Bulk generation into contiguous storage; distributions with a
+        // batch kernel use it, and full range 64-bit integers are copied
+        // straight from a block engine
+
+        template <typename RandomDistributon, typename RandomEngine>
+        void random_fill(RandomDistributon& dist, RandomEngine& rng, typename RandomDistributon::result_type* out, size_t n) {
+            using T = typename RandomDistributon::result_type;
+            if constexpr (has_batch_generate<RandomDistributon, RandomEngine>) {
+                dist.generate(rng, out, n);
+                return;
+            } else if constexpr (has_block_fill<RandomEngine> && std::is_same_v<RandomDistributon, std::uniform_int_distribution<T>>
+                    && std::is_unsigned_v<T> && sizeof(T) == sizeof(uint64_t)) {
+                if (dist.a() == 0 && dist.b() == std::numeric_limits<T>::max()) {
+                    rng.fill(reinterpret_cast<uint64_t*>(out), n);
+                    return;
+                }
+            }
+            for (size_t i = 0; i < n; ++i)
+                out[i] = dist(rng);
+        }
+
+    }
+
     template <typename RandomDistributon, typename RandomEngine>
     class RandomIterator:
     public TL::InputIterator<RandomIterator<RandomDistributon, RandomEngine>, const typename RandomDistributon::result_type> {
@@ -141,6 +1133,8 @@ namespace RS::Range {
         const value_type& operator*() const noexcept { return value_; }
         RandomIterator& operator++() { --num_; value_ = dist_(*rng_); return *this; }
         bool operator==(const RandomIterator& rhs) const noexcept { return num_ == rhs.num_; }
+        const RandomDistributon& distribution() const noexcept { return dist_; }
+        RandomEngine& engine() const noexcept { return *rng_; }
     private:
         RandomDistributon dist_;
         RandomEngine* rng_;
@@ -150,9 +1144,22 @@ namespace RS::Range {
 
     template <typename Range, typename RandomDistributon, typename RandomEngine>
     Range& operator<<(Range& lhs, const TL::Irange<RandomIterator<RandomDistributon, RandomEngine>>& rhs) {
-        auto i = rhs.begin();
-        for (auto& x: lhs)
-            x = *i++;
+        using value_type = typename RandomDistributon::result_type;
+        if constexpr (Detail::is_contiguous_iterator<TL::RangeIterator<Range>>
+                && std::is_same_v<TL::RangeValue<Range>, value_type>) {
+            auto b = std::begin(lhs), e = std::end(lhs);
+            if (b != e) {
+                auto i = rhs.begin();
+                auto dist = i.distribution();
+                value_type* out = &*b;
+                *out = *i;
+                Detail::random_fill(dist, i.engine(), out + 1, size_t(e - b) - 1);
+            }
+        } else {
+            auto i = rhs.begin();
+            for (auto& x: lhs)
+                x = *i++;
+        }
         return lhs;
     }
 
@@ -162,4 +1169,125 @@ namespace RS::Range {
         return {{d, r, n}, {}};
     }
 
+    // random_stream
+
+    namespace Detail {
+
+        // Philox4x32-10 (Salmon et al, "Parallel random numbers: as easy as
+        // 1, 2, 3")
+
+        inline std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> ctr, std::array<uint32_t, 2> key) noexcept {
+            for (int round = 0; round < 10; ++round) {
+                if (round > 0) {
+                    key[0] += 0x9e3779b9u;
+                    key[1] += 0xbb67ae85u;
+                }
+                uint64_t p0 = uint64_t(0xd2511f53u) * ctr[0];
+                uint64_t p1 = uint64_t(0xcd9e8d57u) * ctr[2];
+                ctr = {{uint32_t(p1 >> 32) ^ ctr[1] ^ key[0], uint32_t(p1),
+                    uint32_t(p0 >> 32) ^ ctr[3] ^ key[1], uint32_t(p0)}};
+            }
+            return ctr;
+        }
+
+    }
+
+    // Counter based engine: output j of stream s is a pure function of
+    // (seed, s, j), so separate streams can be used from separate threads
+    // and still give the same results
+
+    class PhiloxEngine {
+    public:
+        using result_type = uint64_t;
+        PhiloxEngine() noexcept { seed(0); }
+        explicit PhiloxEngine(uint64_t s, uint64_t stream = 0) noexcept { seed(s, stream); }
+        result_type operator()() noexcept {
+            if (pos_ == 2) {
+                auto block = Detail::philox4x32({{uint32_t(counter_), uint32_t(counter_ >> 32),
+                    uint32_t(stream_), uint32_t(stream_ >> 32)}}, key_);
+                buffer_[0] = block[0] | (uint64_t(block[1]) << 32);
+                buffer_[1] = block[2] | (uint64_t(block[3]) << 32);
+                ++counter_;
+                pos_ = 0;
+            }
+            return buffer_[pos_++];
+        }
+        void fill(uint64_t* out, size_t n) noexcept {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = (*this)();
+        }
+        void seed(uint64_t s, uint64_t stream = 0) noexcept {
+            key_ = {{uint32_t(s), uint32_t(s >> 32)}};
+            stream_ = stream;
+            counter_ = 0;
+            pos_ = 2;
+        }
+        PhiloxEngine fork() noexcept {
+            auto e = *this;
+            ++counter_;
+            pos_ = 2;
+            return e;
+        }
+        PhiloxEngine split(uint64_t i) const noexcept {
+            // The child stream is a hash of (stream, counter, i) under this
+            // key, so children of different parent states are independent
+            auto block = Detail::philox4x32({{uint32_t(i), uint32_t(i >> 32), uint32_t(counter_), uint32_t(counter_ >> 32)}},
+                {{key_[0] ^ uint32_t(stream_), key_[1] ^ uint32_t(stream_ >> 32)}});
+            PhiloxEngine e;
+            e.key_ = key_;
+            e.stream_ = block[0] | (uint64_t(block[1]) << 32);
+            return e;
+        }
+        uint64_t stream() const noexcept { return stream_; }
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+    private:
+        std::array<uint32_t, 2> key_ = {};
+        uint64_t stream_ = 0;
+        uint64_t counter_ = 0;
+        uint64_t buffer_[2] = {};
+        size_t pos_ = 2;
+    };
+
+    template <typename RandomDistributon>
+    class RandomStreamIterator:
+    public Detail::FlexibleIterator<RandomStreamIterator<RandomDistributon>, const typename RandomDistributon::result_type> {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename RandomDistributon::result_type;
+        RandomStreamIterator() = default;
+        RandomStreamIterator(RandomDistributon d, uint64_t seed, size_t i): dist_(d), seed_(seed), index_(i) {}
+        const value_type& operator*() const {
+            if (! ok_) {
+                value_ = value_at(index_);
+                ok_ = true;
+            }
+            return value_;
+        }
+        value_type operator[](ptrdiff_t i) const { return value_at(index_ + size_t(i)); }
+        RandomStreamIterator& operator++() noexcept { ++index_; ok_ = false; return *this; }
+        RandomStreamIterator& operator--() noexcept { --index_; ok_ = false; return *this; }
+        RandomStreamIterator& operator+=(ptrdiff_t rhs) noexcept { index_ += size_t(rhs); ok_ = false; return *this; }
+        ptrdiff_t operator-(const RandomStreamIterator& rhs) const noexcept { return ptrdiff_t(index_ - rhs.index_); }
+        bool operator==(const RandomStreamIterator& rhs) const noexcept { return index_ == rhs.index_; }
+        size_t index() const noexcept { return index_; }
+    private:
+        RandomDistributon dist_;
+        uint64_t seed_ = 0;
+        size_t index_ = 0;
+        mutable value_type value_ = {};
+        mutable bool ok_ = false;
+        value_type value_at(size_t i) const {
+            auto dist = dist_;
+            PhiloxEngine rng(seed_, i);
+            return dist(rng);
+        }
+    };
+
+    template <typename RandomDistributon>
+    inline TL::Irange<RandomStreamIterator<RandomDistributon>>
+    random_stream(RandomDistributon d, uint64_t seed, size_t n = npos) {
+        return {{d, seed, 0}, {d, seed, n}};
+    }
+
 }
@@ -6,7 +6,11 @@
 #include <functional>
 #include <iterator>
 #include <numeric>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace RS::Range {
 
@@ -200,6 +204,46 @@ namespace RS::Range {
 
     constexpr IsSortedObject<std::less<>> is_sorted = {};
 
+    // join
+
+    template <typename C>
+    struct JoinObject:
+    AlgorithmBase<JoinObject<C>> {
+        std::basic_string<C> sep;
+        JoinObject(std::basic_string_view<C> s): sep(s) {}
+    };
+
+    template <typename Range, typename C>
+    std::basic_string<C> operator>>(const Range& lhs, const JoinObject<C>& rhs) {
+        using view_type = std::basic_string_view<C>;
+        auto r = Detail::as_range(lhs);
+        static_assert(std::is_convertible_v<decltype(*r.begin()), view_type>);
+        std::basic_string<C> result;
+        if constexpr (Detail::is_storage_iterator<Range, decltype(r.begin())>) {
+            size_t n = 0, len = 0;
+            for (auto& s: r) {
+                len += view_type(s).size();
+                ++n;
+            }
+            if (n == 0)
+                return result;
+            result.reserve(len + (n - 1) * rhs.sep.size());
+        }
+        bool first = true;
+        for (auto&& s: r) {
+            if (! first)
+                result.append(rhs.sep);
+            result.append(view_type(s));
+            first = false;
+        }
+        return result;
+    }
+
+    inline JoinObject<char> join(std::string_view sep) { return sep; }
+    inline JoinObject<char16_t> join(std::u16string_view sep) { return sep; }
+    inline JoinObject<char32_t> join(std::u32string_view sep) { return sep; }
+    inline JoinObject<wchar_t> join(std::wstring_view sep) { return sep; }
+
     // min, max, min_max
 
     template <typename ComparisonPredicate>
@@ -343,4 +387,60 @@ namespace RS::Range {
     constexpr SumObject<void> sum = {};
     constexpr ProductObject<void> product = {};
 
+    // par_sum
+
+    namespace Detail {
+
+        // Partial sums are taken over fixed size blocks and combined in
+        // order, so the result does not depend on the number of threads
+
+        constexpr size_t sum_block_size = 0x1000;
+
+        template <typename T, typename RandomAccessIterator>
+        T parallel_sum(RandomAccessIterator b, size_t n, T init) {
+            size_t blocks = (n + sum_block_size - 1) / sum_block_size;
+            std::vector<T> partial(blocks, T());
+            size_t tasks = std::min(parallel_tasks(n), std::max(blocks, size_t(1)));
+            parallel_for(tasks, [&] (size_t k) {
+                for (size_t i = blocks * k / tasks, j = blocks * (k + 1) / tasks; i < j; ++i) {
+                    auto p = b + i * sum_block_size;
+                    auto q = b + std::min((i + 1) * sum_block_size, n);
+                    partial[i] = std::accumulate(p, q, T());
+                }
+            });
+            return std::accumulate(partial.begin(), partial.end(), init);
+        }
+
+    }
+
+    template <typename T>
+    struct ParSumObject:
+    AlgorithmBase<ParSumObject<T>> {
+        T init;
+        ParSumObject(const T& t): init(t) {}
+    };
+
+    template <>
+    struct ParSumObject<void>:
+    AlgorithmBase<ParSumObject<void>> {
+        template <typename T> ParSumObject<T> operator()(const T& t) const { return {t}; }
+    };
+
+    template <typename Range, typename T>
+    T operator>>(const Range& lhs, const ParSumObject<T>& rhs) {
+        auto r = Detail::as_range(lhs);
+        if constexpr (Detail::category_equals<decltype(r.begin()), std::random_access_iterator_tag>
+                && Detail::can_store_in_parallel<T>)
+            return Detail::parallel_sum(r.begin(), std::distance(r.begin(), r.end()), rhs.init);
+        else
+            return std::accumulate(r.begin(), r.end(), rhs.init);
+    }
+
+    template <typename Range>
+    TL::RangeValue<Range> operator>>(const Range& lhs, const ParSumObject<void>& /*rhs*/) {
+        return lhs >> ParSumObject<TL::RangeValue<Range>>(TL::RangeValue<Range>());
+    }
+
+    constexpr ParSumObject<void> par_sum = {};
+
 }
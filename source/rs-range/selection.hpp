@@ -1,11 +1,14 @@
 #pragma once
 
 #include "rs-range/core.hpp"
+#include "rs-range/generation.hpp"
 #include "rs-tl/iterator.hpp"
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <random>
+#include <type_traits>
 #include <utility>
 
 namespace RS::Range {
@@ -302,8 +305,7 @@ namespace RS::Range {
         size_t n = std::distance(b, e), m = std::min(rhs.num, n);
         auto result = Detail::make_shared_range<TL::RangeValue<RandomAccessRange>>(b, b + m);
         for (size_t i = m; i < n; ++i) {
-            std::uniform_int_distribution<size_t> dist(0, i - 1);
-            auto j = dist(*rhs.rng);
+            auto j = Detail::uniform_index(*rhs.rng, i);
             if (j < m)
                 result.first[j] = b[i];
         }
@@ -323,6 +325,22 @@ namespace RS::Range {
         return {k, &rng};
     }
 
+    namespace Detail {
+
+        // Counter based engines, such as PhiloxEngine, can split off an
+        // independent stream per element; sampling with one forks the engine
+        // once per call, so each element's draw depends only on the engine's
+        // state at the call and the element's position
+
+        template <typename RandomEngine, typename = void> struct HasSplit: std::false_type {};
+        template <typename RandomEngine>
+            struct HasSplit<RandomEngine, std::void_t<decltype(std::declval<const RandomEngine&>().split(uint64_t())),
+                decltype(std::declval<RandomEngine&>().fork())>>:
+            std::true_type {};
+        template <typename RandomEngine> constexpr bool has_split = HasSplit<RandomEngine>::value;
+
+    }
+
     // sample_p
 
     template <typename RandomEngine>
@@ -342,17 +360,31 @@ namespace RS::Range {
         using value_type = TL::RangeValue<Range>;
         SampleByProbIterator() = default;
         SampleByProbIterator(underlying_iterator i, underlying_iterator e, double p, RandomEngine* r):
-            iter_(i), end_(e), dist_(p), rng_(r) { update(); }
+            iter_(i), end_(e), dist_(p), rng_(r) {
+                if constexpr (Detail::has_split<RandomEngine>)
+                    if (r)
+                        fork_ = r->fork();
+                update();
+            }
         const auto& operator*() const noexcept { return *iter_; }
-        SampleByProbIterator& operator++() { ++iter_; update(); return *this; }
+        SampleByProbIterator& operator++() { ++iter_; ++index_; update(); return *this; }
         bool operator==(const SampleByProbIterator& rhs) const noexcept { return iter_ == rhs.iter_; }
     private:
         underlying_iterator iter_;
         underlying_iterator end_;
-        std::bernoulli_distribution dist_;
-        double prob = 0;
+        BernoulliDistribution dist_;
         RandomEngine* rng_ = nullptr;
-        void update() { while (iter_ != end_ && ! dist_(*rng_)) ++iter_; }
+        std::conditional_t<Detail::has_split<RandomEngine>, RandomEngine, char> fork_ = {};
+        size_t index_ = 0;
+        bool keep() {
+            if constexpr (Detail::has_split<RandomEngine>) {
+                auto rng = fork_.split(index_);
+                return dist_(rng);
+            } else {
+                return dist_(*rng_);
+            }
+        }
+        void update() { while (iter_ != end_ && ! keep()) { ++iter_; ++index_; } }
     };
 
     template <typename Range, typename RandomEngine>
@@ -365,8 +397,22 @@ namespace RS::Range {
     template <typename Container, typename RandomEngine>
     Container& operator<<(Container& lhs, SampleByProbObject<RandomEngine> rhs) {
         Container temp;
-        std::bernoulli_distribution dist(rhs.prob);
-        std::copy_if(lhs.begin(), lhs.end(), append(temp), [&] (auto&) { return dist(*rhs.rng); });
+        BernoulliDistribution dist(rhs.prob);
+        if constexpr (Detail::has_split<RandomEngine>) {
+            auto fork = rhs.rng->fork();
+            size_t i = 0;
+            std::copy_if(lhs.begin(), lhs.end(), append(temp), [&] (auto&) { auto rng = fork.split(i++); return dist(rng); });
+        } else {
+            bool mask[Detail::random_block_size];
+            size_t i = Detail::random_block_size;
+            std::copy_if(lhs.begin(), lhs.end(), append(temp), [&] (auto&) {
+                if (i == Detail::random_block_size) {
+                    dist.generate(*rhs.rng, mask, i);
+                    i = 0;
+                }
+                return mask[i++];
+            });
+        }
         lhs = std::move(temp);
         return lhs;
     }
@@ -392,9 +438,28 @@ namespace RS::Range {
         auto b = r.begin(), e = r.end();
         size_t n = std::distance(b, e);
         auto result = Detail::make_shared_range<TL::RangeValue<RandomAccessRange>>(rhs.num);
-        std::uniform_int_distribution<size_t> dist(0, n - 1);
-        for (auto& x: result)
-            x = b[dist(*rhs.rng)];
+        UniformIntDistribution<size_t> dist(0, n - 1);
+        if constexpr (Detail::has_split<RandomEngine> && Detail::can_store_in_parallel<TL::RangeValue<RandomAccessRange>>) {
+            auto out = result.begin();
+            auto fork = rhs.rng->fork();
+            size_t tasks = Detail::parallel_tasks(rhs.num);
+            Detail::parallel_for(tasks, [&] (size_t k) {
+                auto d = dist;
+                for (size_t i = rhs.num * k / tasks, j = rhs.num * (k + 1) / tasks; i < j; ++i) {
+                    auto rng = fork.split(i);
+                    out[i] = b[d(rng)];
+                }
+            });
+        } else {
+            size_t index[Detail::random_block_size];
+            auto out = result.begin();
+            for (size_t i = 0; i < rhs.num; i += Detail::random_block_size) {
+                size_t m = std::min(rhs.num - i, Detail::random_block_size);
+                dist.generate(*rhs.rng, index, m);
+                for (size_t j = 0; j < m; ++j)
+                    out[i + j] = b[index[j]];
+            }
+        }
         return result;
     }
 
@@ -1,10 +1,14 @@
 #include "rs-range/aggregation.hpp"
+#include "rs-range/generation.hpp"
+#include "rs-range/reduction.hpp"
+#include "rs-range/transformation.hpp"
 #include "rs-format/string.hpp"
 #include "rs-tl/iterator.hpp"
 #include "rs-unit-test.hpp"
 #include <functional>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using namespace RS::Format;
@@ -212,3 +216,64 @@ void test_rs_range_aggregation_partial_sum() {
     TRY(v1 >> passthrough * partial_sum * passthrough >> overwrite(v2));  TEST_EQUAL(format_range(v2), "[1,3,6,10,15]");
 
 }
+
+void test_rs_range_aggregation_split() {
+
+    std::string s;
+    std::vector<std::string_view> v;
+
+    TRY(""s >> split(",") >> overwrite(v));           TEST_EQUAL(v.size(), 0u);
+    TRY(","s >> split(",") >> overwrite(v));          TEST_EQUAL(v.size(), 2u);
+    TRY("abc"s >> split(",") >> overwrite(v));        TEST_EQUAL(format_range(v), "[abc]");
+    TRY("a,b,,c"s >> split(",") >> overwrite(v));     TEST_EQUAL(format_range(v), "[a,b,,c]");
+    TRY("a,b,,c"s >> split("") >> overwrite(v));      TEST_EQUAL(format_range(v), "[a,b,,c]");
+    TRY("a b\tc;d"s >> split(" \t;") >> overwrite(v));  TEST_EQUAL(format_range(v), "[a,b,c,d]");
+
+    std::string_view text = "alpha:bravo;charlie,delta echo\tfoxtrot golf:hotel";
+    TRY(text >> split(" \t") >> overwrite(v));
+    TEST_EQUAL(format_range(v), "[alpha:bravo;charlie,delta,echo,foxtrot,golf:hotel]");
+    TRY(text >> split(" \t:;,") >> overwrite(v));
+    TEST_EQUAL(format_range(v), "[alpha,bravo,charlie,delta,echo,foxtrot,golf,hotel]");
+    TEST_EQUAL(text >> split(":;,") >> count, 5u);
+
+    std::string delims = " ,;:/|";
+    s.clear();
+    for (int i = 0; i < 1000; ++i)
+        s += i % 7 == 0 ? delims[size_t(i % 6)] : char('a' + i % 26);
+
+    for (size_t k = 1; k <= delims.size(); ++k) {
+        auto d = delims.substr(0, k);
+        std::vector<std::string_view> expect;
+        size_t p = 0;
+        for (;;) {
+            auto q = s.find_first_of(d, p);
+            expect.push_back(std::string_view(s).substr(p, q == std::string::npos ? std::string::npos : q - p));
+            if (q == std::string::npos)
+                break;
+            p = q + 1;
+        }
+        TRY(s >> split(d) >> overwrite(v));
+        TEST(v == expect);
+    }
+
+    std::vector<std::string_view> rows = {"a,b", "", "c,d,e"};
+    s.clear();
+    for (auto& fields: rows >> split(","))
+        s += "[" + std::to_string(fields >> count) + "]";
+    TEST_EQUAL(s, "[2][0][3]");
+
+    std::vector<std::string> words = {"a,b", "c,d,e"};
+    auto nested = words >> map([] (const std::string& t) { return t + ",x"; }) >> split(",");
+    auto it = nested.begin();
+    auto first = *it;
+    TRY(++it);
+    TEST_EQUAL(format_range(first), "[a,b,x]");
+    TEST_EQUAL(format_range(*it), "[c,d,e,x]");
+
+    std::string_view rowtext = "a,b\nc";
+    auto byline = lines(rowtext) >> split(",");
+    auto field = (*byline.begin()).begin();
+    TEST_EQUAL(*field, "a");
+    TEST((*field).data() == rowtext.data());
+
+}
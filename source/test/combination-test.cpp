@@ -1,9 +1,21 @@
 #include "rs-range/combination.hpp"
+#include "rs-range/reduction.hpp"
+#include "rs-range/selection.hpp"
+#include "rs-range/transformation.hpp"
 #include "rs-tl/iterator.hpp"
 #include "rs-unit-test.hpp"
+#include "test/parallel-limits.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <atomic>
 #include <functional>
+#include <iterator>
+#include <list>
 #include <map>
+#include <numeric>
+#include <random>
 #include <string>
+#include <tuple>
 #include <vector>
 
 using namespace RS::Range;
@@ -11,6 +23,84 @@ using namespace RS::TL;
 using namespace RS::UnitTest;
 using namespace std::literals;
 
+namespace {
+
+    std::vector<int> sorted_sample(size_t n, int range, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> dist(0, range);
+        std::vector<int> v(n);
+        for (auto& x: v)
+            x = dist(rng);
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+
+}
+
+void test_rs_range_combination_cartesian_product() {
+
+    std::vector<int> a = {1, 2, 3};
+    std::string b = "xy";
+    std::vector<double> c = {0.5, 1.5};
+    std::list<int> l = {10, 20};
+    std::vector<int> e;
+    std::vector<std::tuple<int, char, double>> v;
+
+    auto r = cartesian_product(a, b, c);
+    TEST_EQUAL(r.end() - r.begin(), 12);
+    TRY(r >> overwrite(v));
+    TEST_EQUAL(v.size(), 12u);
+    TEST(v[0] == std::make_tuple(1, 'x', 0.5));
+    TEST(v[1] == std::make_tuple(1, 'x', 1.5));
+    TEST(v[2] == std::make_tuple(1, 'y', 0.5));
+    TEST(v[5] == std::make_tuple(2, 'x', 1.5));
+    TEST(v[11] == std::make_tuple(3, 'y', 1.5));
+    TEST(std::is_sorted(v.begin(), v.end()));
+
+    for (int i = 0; i <= 12; ++i) {
+        auto j = r.begin() + i;
+        TEST_EQUAL(j.index(), size_t(i));
+        TEST_EQUAL(j - r.begin(), i);
+        if (i < 12) {
+            TEST(*j == v[i]);
+            TEST(r.begin()[i] == v[i]);
+            TEST(*(r.end() - (12 - i)) == v[i]);
+        }
+    }
+    auto k = r.end();
+    for (int i = 11; i >= 0; --i)
+        TEST(*--k == v[i]);
+    TEST(k == r.begin());
+    TEST_EQUAL(*(r.begin() + 7).current<2>(), 1.5);
+
+    auto fr = cartesian_product(l, b);
+    std::vector<std::tuple<int, char>> w;
+    TRY(fr >> overwrite(w));
+    TEST_EQUAL(w.size(), 4u);
+    TEST(w[0] == std::make_tuple(10, 'x'));
+    TEST(w[3] == std::make_tuple(20, 'y'));
+
+    auto er = cartesian_product(a, e, b);
+    TEST(er.begin() == er.end());
+    auto one = cartesian_product(a);
+    TEST_EQUAL(one.end() - one.begin(), 3);
+
+    std::vector<int> big(100);
+    std::iota(big.begin(), big.end(), 0);
+    auto grid = cartesian_product(big, big, a);
+    std::atomic<int64_t> total(0);
+    int64_t expect = 0;
+    for (auto& t: grid)
+        expect += std::get<0>(t) * 10000 + std::get<1>(t) * 10 + std::get<2>(t);
+    {
+        ParallelLimitsOverride limits(4, 1);
+        TRY(grid >> par_each([&total] (const auto& t) { total += std::get<0>(t) * 10000 + std::get<1>(t) * 10 + std::get<2>(t); }));
+    }
+    TEST_EQUAL(total.load(), expect);
+
+}
+
 void test_rs_range_combination_compare() {
 
     std::string s1, s2;
@@ -40,6 +130,39 @@ void test_rs_range_combination_compare() {
     s1 = "hello";  s2 = "world";        TEST(! (s1 >> is_equivalent(s2)));  TEST(! (s2 >> is_equivalent(s1)));
     s1 = "hello";  s2 = "hello world";  TEST(! (s1 >> is_equivalent(s2)));  TEST(! (s2 >> is_equivalent(s1)));
 
+    std::vector<unsigned char> b1(1000, 7), b2;
+    std::vector<int> i1(1000, 7), i2;
+    std::vector<uint32_t> u1(1000, 0x00ff), u2;
+    std::vector<signed char> c1(1000, 7), c2;
+
+    for (size_t pos: {0, 1, 63, 64, 255, 256, 999}) {
+        for (int delta: {-1, 1}) {
+            b2 = b1;  b2[pos] = static_cast<unsigned char>(b2[pos] + delta * 200);
+            i2 = i1;  i2[pos] = -1000 * delta;
+            u2 = u1;  u2[pos] = delta < 0 ? 0x0001 : 0x0100;
+            c2 = c1;  c2[pos] = static_cast<signed char>(-100 * delta);
+            TEST_EQUAL(b1 >> compare(b2), std::lexicographical_compare(b1.begin(), b1.end(), b2.begin(), b2.end()));
+            TEST_EQUAL(b2 >> compare(b1), std::lexicographical_compare(b2.begin(), b2.end(), b1.begin(), b1.end()));
+            TEST_EQUAL(i1 >> compare(i2), std::lexicographical_compare(i1.begin(), i1.end(), i2.begin(), i2.end()));
+            TEST_EQUAL(i2 >> compare(i1), std::lexicographical_compare(i2.begin(), i2.end(), i1.begin(), i1.end()));
+            TEST_EQUAL(u1 >> compare(u2), std::lexicographical_compare(u1.begin(), u1.end(), u2.begin(), u2.end()));
+            TEST_EQUAL(u2 >> compare(u1), std::lexicographical_compare(u2.begin(), u2.end(), u1.begin(), u1.end()));
+            TEST_EQUAL(c1 >> compare(c2), std::lexicographical_compare(c1.begin(), c1.end(), c2.begin(), c2.end()));
+            TEST_EQUAL(c2 >> compare(c1), std::lexicographical_compare(c2.begin(), c2.end(), c1.begin(), c1.end()));
+            TEST_EQUAL(b1 >> compare_3way(b2), - (b2 >> compare_3way(b1)));
+            TEST_EQUAL(u1 >> compare_3way(u2), u1[pos] < u2[pos] ? -1 : 1);
+            TEST_EQUAL(i1 >> compare_3way(i2), i1[pos] < i2[pos] ? -1 : 1);
+            TEST(! (b1 >> is_equal(b2)));
+            TEST(! (i1 >> is_equal(i2)));
+            TEST(! (u1 >> is_equivalent(u2)));
+        }
+    }
+
+    b2 = b1;  TEST(b1 >> is_equal(b2));  TEST(b1 >> is_equivalent(b2));  TEST_EQUAL(b1 >> compare_3way(b2), 0);
+    i2 = i1;  TEST(i1 >> is_equal(i2));  TEST(i1 >> is_equivalent(i2));  TEST_EQUAL(i1 >> compare_3way(i2), 0);
+    b2.pop_back();  TEST(! (b1 >> is_equal(b2)));  TEST_EQUAL(b1 >> compare_3way(b2), 1);  TEST(b2 >> compare(b1));
+    i2.pop_back();  TEST(! (i1 >> is_equal(i2)));  TEST_EQUAL(i1 >> compare_3way(i2), 1);  TEST(i2 >> compare(i1));
+
 }
 
 void test_rs_range_combination_concat() {
@@ -62,6 +185,86 @@ void test_rs_range_combination_concat() {
     TRY(s2 >> prefix(s1) * passthrough >> overwrite(t));                TEST_EQUAL(t, "HelloWorld");
     TRY(s2 >> passthrough * prefix(s1) * passthrough >> overwrite(t));  TEST_EQUAL(t, "HelloWorld");
 
+    std::string s3 = "", s4 = "!";
+    std::list<char> l1 = {'x','y','z'};
+
+    TRY(s1 >> concat(s2, s3, s4) >> overwrite(t));               TEST_EQUAL(t, "HelloWorld!");
+    TRY(s3 >> concat(s1, s3, s2) >> overwrite(t));               TEST_EQUAL(t, "HelloWorld");
+    TRY(s3 >> concat(s3) >> overwrite(t));                       TEST_EQUAL(t, "");
+    TRY(s1 >> concat(l1, s2) >> overwrite(t));                   TEST_EQUAL(t, "HelloxyzWorld");
+    TRY(s1 >> passthrough >> concat(s2, s4) >> overwrite(t));    TEST_EQUAL(t, "HelloWorld!");
+    t = s1;  TRY(t << concat(s2, s3, s4));                       TEST_EQUAL(t, "HelloWorld!");
+
+    auto r1 = s1 >> concat(s3, s2, s4);
+    TEST_EQUAL(std::distance(r1.begin(), r1.end()), 11);
+    TEST_EQUAL(r1.begin()[0], 'H');
+    TEST_EQUAL(r1.begin()[4], 'o');
+    TEST_EQUAL(r1.begin()[5], 'W');
+    TEST_EQUAL(r1.begin()[10], '!');
+    TEST_EQUAL(*(r1.end() - 6), 'W');
+    TEST_EQUAL((r1.begin() + 7) - (r1.begin() + 2), 5);
+    TEST((r1.begin() + 5) == (r1.end() - 6));
+    TRY(std::reverse_copy(r1.begin(), r1.end(), overwrite(t)));  TEST_EQUAL(t, "!dlroWolleH");
+    TRY(r1 >> skip(3) >> overwrite(t));                          TEST_EQUAL(t, "loWorld!");
+
+    size_t n = 0;
+    std::string u;
+    auto r2 = s1 >> concat(l1, s2);
+    TRY(n = r2 >> count);                                                TEST_EQUAL(n, 13u);
+    TRY(n = r2 >> count('l'));                                           TEST_EQUAL(n, 3u);
+    TRY(n = r2 >> count_if([] (char c) { return c > 'n'; }));           TEST_EQUAL(n, 6u);
+    TRY(t = r2 >> sum(""s));                                             TEST_EQUAL(t, "HelloxyzWorld");
+    TRY(r2 >> each([&u] (char c) { u += c; u += '.'; }));                TEST_EQUAL(u, "H.e.l.l.o.x.y.z.W.o.r.l.d.");
+    TRY(r2 >> collect >> overwrite(t));                                  TEST_EQUAL(t, "HelloxyzWorld");
+    TRY(r2 >> passthrough >> collect >> overwrite(t));                   TEST_EQUAL(t, "HelloxyzWorld");
+    t.clear();
+    TRY(r2 >> output(std::back_inserter(t)));                            TEST_EQUAL(t, "HelloxyzWorld");
+
+    std::vector<int> v1 = {1,2,3}, v2, v3 = {4,5}, v4 = {6};
+    int x = 0;
+    TRY(x = v1 >> concat(v2, v3, v4) >> sum);      TEST_EQUAL(x, 21);
+    TRY(x = v2 >> concat(v2) >> sum);              TEST_EQUAL(x, 0);
+    TRY(x = v1 >> concat(v3) >> skip(1) >> sum);  TEST_EQUAL(x, 14);
+
+}
+
+void test_rs_range_combination_hash_join() {
+
+    using record = std::pair<int, std::string>;
+    std::vector<record> events = {{3,"c1"}, {1,"a1"}, {4,"d1"}, {1,"a2"}, {5,"e1"}, {9,"i1"}, {2,"b1"}, {6,"f1"}};
+    std::vector<record> dims = {{1,"one"}, {2,"two"}, {3,"three"}, {5,"five"}, {5,"cinq"}};
+    std::vector<record> none;
+    std::vector<std::string> v;
+    auto key = [] (const record& r) { return r.first; };
+    auto show = [] (const std::pair<record, record>& p) { return p.first.second + ":" + p.second.second; };
+
+    // Right side smaller: table built on the right, output follows the left
+    v.clear();
+    TRY(events >> hash_join(dims, key, key) >> each([&] (auto& p) { v.push_back(show(p)); }));
+    TEST_EQUAL(format_range(v), "[c1:three,a1:one,a2:one,e1:five,e1:cinq,b1:two]");
+
+    // Left side smaller: table built on the left, output follows the right
+    v.clear();
+    TRY(dims >> hash_join(events, key, key) >> each([&] (auto& p) { v.push_back(p.first.second + ":" + p.second.second); }));
+    TEST_EQUAL(format_range(v), "[three:c1,one:a1,one:a2,five:e1,cinq:e1,two:b1]");
+
+    v.clear();
+    TRY(events >> hash_join(none, key, key) >> each([&] (auto& p) { v.push_back(show(p)); }));
+    TEST_EQUAL(format_range(v), "[]");
+    TRY(none >> hash_join(events, key, key) >> each([&] (auto& p) { v.push_back(show(p)); }));
+    TEST_EQUAL(format_range(v), "[]");
+
+    std::vector<int> i1 = {5,1,4,1,5,9,2,6,5,3,5}, i2 = {1,5,7}, i3;
+    TRY(i1 >> hash_join(i2) >> each([&] (auto& p) { i3.push_back(p.first * 10 + p.second); }));
+    TEST_EQUAL(format_range(i3), "[55,11,11,55,55,55]");
+    TEST_EQUAL(i1 >> hash_join(i2) >> count, 6u);
+
+    std::vector<int> big(10000);
+    for (size_t i = 0; i < big.size(); ++i)
+        big[i] = int(i * 7 % 10000);
+    i3 = {0, 7, 9999, 10000};
+    TEST_EQUAL(big >> hash_join(i3) >> count, 3u);
+
 }
 
 void test_rs_range_combination_inner_product() {
@@ -80,6 +283,43 @@ void test_rs_range_combination_inner_product() {
     TRY(n = v1 >> (passthrough * inner_product(v2)));             TEST_EQUAL(n, 106);
     TRY(n = v2 >> (passthrough * inner_product(v1)));             TEST_EQUAL(n, 106);
 
+    std::vector<double> d1(10000), d2(10000);
+    std::vector<int> i1(10000), i2(10000);
+    for (size_t i = 0; i < d1.size(); ++i) {
+        d1[i] = 1.0 / double(i + 1);
+        d2[i] = double(i % 7) - 3.0;
+        i1[i] = int(i % 13) - 6;
+        i2[i] = int(i % 11);
+    }
+    double x = 0, y = 0, z = 0;
+    long long expect = 0;
+    for (size_t i = 0; i < i1.size(); ++i)
+        expect += i1[i] * i2[i];
+
+    for (size_t len: {0, 1, 7, 31, 32, 33, 1000, 10000}) {
+        std::vector<double> e1(d1.begin(), d1.begin() + len), e2(d2.begin(), d2.begin() + len);
+        TRY(x = e1 >> inner_product(e2));
+        TEST_NEAR(x, std::inner_product(e1.begin(), e1.end(), e2.begin(), 0.0), 1e-9);
+    }
+
+    TRY(n = i1 >> inner_product(i2));           TEST_EQUAL(n, expect);
+    TRY(n = i1 >> par_inner_product(i2));       TEST_EQUAL(n, expect);
+    TRY(x = d1 >> par_inner_product(d2, 0.0, std::multiplies<>(), std::plus<>()));
+    TEST_NEAR(x, std::inner_product(d1.begin(), d1.end(), d2.begin(), 0.0), 1e-9);
+
+    {
+        ParallelLimitsOverride limits(1, 1);
+        TRY(y = d1 >> par_inner_product(d2));
+    }
+    {
+        ParallelLimitsOverride limits(4, 1);
+        TRY(z = d1 >> par_inner_product(d2));
+        TEST_EQUAL(y, z);
+        TRY(n = i1 >> par_inner_product(i2));                         TEST_EQUAL(n, expect);
+        TRY(n = v1 >> par_inner_product(v2, 42, f1, std::plus<>()));  TEST_EQUAL(n, 42 + 1 * 4 + 2 * 9 + 3 * 25 + 4 * 49 + 5 * 121);
+        TRY(n = v1 >> passthrough >> par_inner_product(v2));          TEST_EQUAL(n, 106);
+    }
+
 }
 
 void test_rs_range_combination_interleave() {
@@ -114,6 +354,89 @@ void test_rs_range_combination_interleave() {
     TRY(s1 >> interleave(s2) * passthrough >> overwrite(s3));                TEST_EQUAL(s3, "hweolrllod");
     TRY(s1 >> passthrough * interleave(s2) * passthrough >> overwrite(s3));  TEST_EQUAL(s3, "hweolrllod");
 
+    std::string s4, s5;
+
+    s1 = "abc";  s2 = "def";  s4 = "ghi";  TRY(s1 >> interleave(s2, s4) >> overwrite(s3));  TEST_EQUAL(s3, "adgbehcfi");
+    s1 = "abc";  s2 = "";     s4 = "ghi";  TRY(s1 >> interleave(s2, s4) >> overwrite(s3));  TEST_EQUAL(s3, "agbhci");
+    s1 = "a";    s2 = "def";  s4 = "gh";   TRY(s1 >> interleave(s2, s4) >> overwrite(s3));  TEST_EQUAL(s3, "adgehf");
+    s1 = "abcd"; s2 = "e";    s4 = "fg";   TRY(s1 >> interleave(s2, s4) >> overwrite(s3));  TEST_EQUAL(s3, "aefbgcd");
+    s1 = "abc";  s2 = "def";  s4 = "ghi";  TRY(s1 >> passthrough >> interleave(s2, s4) >> passthrough >> overwrite(s3));  TEST_EQUAL(s3, "adgbehcfi");
+    s1 = "abc";  s2 = "def";  s4 = "ghi";  TRY(s1 << interleave(s2, s4));  TEST_EQUAL(s1, "adgbehcfi");
+
+    std::vector<int> v1, v2, v3, v4, v5;
+
+    for (int i = 0; i < 1000; ++i) {
+        v1.push_back(3 * i);
+        v2.push_back(3 * i + 1);
+        v3.push_back(3 * i + 2);
+    }
+
+    TRY(v1 >> interleave(v2, v3) >> overwrite(v4));
+    TEST_EQUAL(v4.size(), 3000u);
+    for (int i = 0; i < 3000; ++i)
+        TEST_EQUAL(v4[i], i);
+    TRY(v5.clear());
+    TRY(v1 >> interleave(v2, v3) >> append(v5));
+    TEST(v5 == v4);
+    TRY(v3.resize(900));
+    TRY(v1 >> interleave(v2, v3) >> overwrite(v4));
+    TEST_EQUAL(v4.size(), 2900u);
+    TEST_EQUAL(v4[2699], 2699);
+    TEST_EQUAL(v4[2700], 2700);
+    TEST_EQUAL(v4[2701], 2701);
+    TEST_EQUAL(v4[2702], 2703);
+    TEST_EQUAL(v4[2899], 2998);
+    auto ii = v1 >> interleave(v2, v3);
+    auto it = std::next(ii.begin(), 5);
+    TRY(v5.clear());
+    TRY((Irange<decltype(it)>{it, ii.end()} >> append(v5)));
+    TEST_EQUAL(v5.size(), 2895u);
+    TEST_EQUAL(v5[0], 5);
+    TEST_EQUAL(v5[2894], 2998);
+
+    std::vector<std::string> vs;
+
+    s1 = "";            TRY(s1 >> deinterleave(2) >> each([&] (auto& r) { vs.push_back(std::string(r.begin(), r.end())); }));  TEST_EQUAL(vs.size(), 2u);  TEST_EQUAL(vs[0], "");  TEST_EQUAL(vs[1], "");
+    vs.clear();
+    s1 = "hweolrllod";  TRY(s1 >> deinterleave(2) >> each([&] (auto& r) { vs.push_back(std::string(r.begin(), r.end())); }));  TEST_EQUAL(vs.size(), 2u);  TEST_EQUAL(vs[0], "hello");  TEST_EQUAL(vs[1], "world");
+    vs.clear();
+    s1 = "adgbehcf";    TRY(s1 >> deinterleave(3) >> each([&] (auto& r) { vs.push_back(std::string(r.begin(), r.end())); }));  TEST_EQUAL(vs.size(), 3u);  TEST_EQUAL(vs[0], "abc");    TEST_EQUAL(vs[1], "def");    TEST_EQUAL(vs[2], "gh");
+    vs.clear();
+    s1 = "hello";       TRY(s1 >> deinterleave(1) >> each([&] (auto& r) { vs.push_back(std::string(r.begin(), r.end())); }));  TEST_EQUAL(vs.size(), 1u);  TEST_EQUAL(vs[0], "hello");
+
+    auto parts = s1 >> deinterleave(0);
+    TEST_EQUAL(parts.end() - parts.begin(), 1);
+    s1 = "adgbehcf";
+    parts = s1 >> deinterleave(3);
+    TEST_EQUAL(parts.end() - parts.begin(), 3);
+    TEST_EQUAL(std::string(parts.begin()[2].begin(), parts.begin()[2].end()), "gh");
+
+    for (size_t n = 1; n <= 6; ++n) {
+        std::vector<int> src(1000 + n / 2);
+        std::iota(src.begin(), src.end(), 0);
+        auto lanes = src >> deinterleave(n) >> collect;
+        TEST_EQUAL(size_t(lanes.end() - lanes.begin()), n);
+        size_t total = 0;
+        for (size_t k = 0; k < n; ++k) {
+            auto& lane = lanes.begin()[k];
+            total += lane.size();
+            for (size_t i = 0; i < lane.size(); ++i)
+                TEST_EQUAL(lane[i], int(n * i + k));
+        }
+        TEST_EQUAL(total, src.size());
+    }
+
+    std::list<int> li = {1, 2, 3, 4, 5};
+    auto lanes = li >> deinterleave(2) >> collect;
+    TEST_EQUAL(lanes.end() - lanes.begin(), 2);
+    TEST_EQUAL_RANGES(lanes.begin()[0], (std::vector<int>{1, 3, 5}));
+    TEST_EQUAL_RANGES(lanes.begin()[1], (std::vector<int>{2, 4}));
+
+    TRY(v1 >> interleave(v2) >> overwrite(v4));
+    auto back = v4 >> deinterleave(2) >> collect;
+    TEST(back.begin()[0] == v1);
+    TEST(back.begin()[1] == v2);
+
 }
 
 void test_rs_range_combination_merge() {
@@ -159,6 +482,64 @@ void test_rs_range_combination_merge() {
     TRY(s1 >> merge(s2) * passthrough >> overwrite(s3));                TEST_EQUAL(s3, "aabcdeefiou");
     TRY(s1 >> passthrough * merge(s2) * passthrough >> overwrite(s3));  TEST_EQUAL(s3, "aabcdeefiou");
 
+    ParallelLimitsOverride limits(4, 1);
+    std::vector<int> v1, v2, v3, v4;
+
+    for (size_t n: {0, 1, 2, 3, 10, 100, 1000}) {
+        for (size_t m: {0, 1, 5, 777}) {
+            v1 = sorted_sample(n, 50, 1);
+            v2 = sorted_sample(m, 50, 2);
+            v4.clear();
+            std::merge(v1.begin(), v1.end(), v2.begin(), v2.end(), std::back_inserter(v4));
+            v3 = v1;
+            TRY(v3 << merge(v2));
+            TEST_EQUAL_RANGES(v3, v4);
+        }
+    }
+
+}
+
+void test_rs_range_combination_merge_join() {
+
+    using record = std::pair<int, std::string>;
+    std::vector<record> events = {{1,"a1"}, {1,"a2"}, {2,"b1"}, {3,"c1"}, {4,"d1"}, {5,"e1"}, {6,"f1"}, {9,"i1"}};
+    std::vector<record> dims = {{1,"one"}, {2,"two"}, {3,"three"}, {5,"five"}, {5,"cinq"}, {8,"eight"}};
+    std::vector<record> none;
+    std::vector<std::string> v;
+    auto key = [] (const record& r) { return r.first; };
+
+    v.clear();
+    TRY(events >> merge_join(dims, key, key) >> each([&] (auto& p) { v.push_back(p.first.second + ":" + p.second.second); }));
+    TEST_EQUAL(format_range(v), "[a1:one,a2:one,b1:two,c1:three,e1:five,e1:cinq]");
+
+    v.clear();
+    TRY(events >> left_merge_join(dims, key, key) >> each([&] (auto& p) {
+        v.push_back(p.first.second + ":" + (p.second ? p.second->second : "-"s)); }));
+    TEST_EQUAL(format_range(v), "[a1:one,a2:one,b1:two,c1:three,d1:-,e1:five,e1:cinq,f1:-,i1:-]");
+
+    v.clear();
+    TRY(events >> semi_merge_join(dims, key, key) >> each([&] (auto& r) { v.push_back(r.second); }));
+    TEST_EQUAL(format_range(v), "[a1,a2,b1,c1,e1]");
+
+    v.clear();
+    TRY(events >> anti_merge_join(dims, key, key) >> each([&] (auto& r) { v.push_back(r.second); }));
+    TEST_EQUAL(format_range(v), "[d1,f1,i1]");
+
+    TEST_EQUAL(events >> merge_join(none, key, key) >> count, 0u);
+    TEST_EQUAL(events >> left_merge_join(none, key, key) >> count, 8u);
+    TEST_EQUAL(events >> anti_merge_join(none, key, key) >> count, 8u);
+    TEST_EQUAL(none >> left_merge_join(dims, key, key) >> count, 0u);
+
+    std::vector<int> i1 = {1,1,2,3,5,5,8}, i2 = {1,3,3,5,7}, i3;
+    TRY(i1 >> merge_join(i2) >> each([&] (auto& p) { i3.push_back(p.first * 10 + p.second); }));
+    TEST_EQUAL(format_range(i3), "[11,11,33,33,55,55]");
+    TRY(i1 >> semi_merge_join(i2) >> overwrite(i3));        TEST_EQUAL(format_range(i3), "[1,1,3,5,5]");
+    TRY(i1 >> anti_merge_join(i2) >> overwrite(i3));        TEST_EQUAL(format_range(i3), "[2,8]");
+    TRY(i1 >> passthrough >> semi_merge_join(i2) >> overwrite(i3));  TEST_EQUAL(format_range(i3), "[1,1,3,5,5]");
+
+    std::vector<int> d1 = {8,5,5,3,2,1,1}, d2 = {7,5,3,3,1};
+    TRY(d1 >> semi_merge_join(d2)(std::greater<>()) >> overwrite(i3));  TEST_EQUAL(format_range(i3), "[5,5,3,1,1]");
+
 }
 
 void test_rs_range_combination_outer_product() {
@@ -184,6 +565,50 @@ void test_rs_range_combination_outer_product() {
     TRY(s1 >> self_cross * passthrough >> overwrite(m));                     TEST_EQUAL(format_map(m), "{a:a,a:b,a:c,b:a,b:b,b:c,c:a,c:b,c:c}");
     TRY(s1 >> passthrough * self_cross * passthrough >> overwrite(m));       TEST_EQUAL(format_map(m), "{a:a,a:b,a:c,b:a,b:b,b:c,c:a,c:b,c:c}");
 
+    auto r1 = s1 >> outer_product(s2, f);
+    TEST_EQUAL(std::distance(r1.begin(), r1.end()), 12);
+    TEST_EQUAL(r1.begin()[0], "aa/w");
+    TEST_EQUAL(r1.begin()[1 * 4 + 2], "bb/y");
+    TEST_EQUAL(r1.begin()[2 * 4 + 3], "cc/z");
+    TEST_EQUAL(*std::prev(r1.end()), "cc/z");
+    TEST_EQUAL(*(r1.end() - 5), "bb/z");
+    TRY(std::reverse_copy(r1.begin(), r1.end(), overwrite(v)));  TEST_EQUAL(format_range(v), "[cc/z,cc/y,cc/x,cc/w,bb/z,bb/y,bb/x,bb/w,aa/z,aa/y,aa/x,aa/w]");
+    TRY(r1 >> collect >> overwrite(v));                          TEST_EQUAL(format_range(v), "[aa/w,aa/x,aa/y,aa/z,bb/w,bb/x,bb/y,bb/z,cc/w,cc/x,cc/y,cc/z]");
+    TRY(r1 >> par_collect >> overwrite(v));                      TEST_EQUAL(format_range(v), "[aa/w,aa/x,aa/y,aa/z,bb/w,bb/x,bb/y,bb/z,cc/w,cc/x,cc/y,cc/z]");
+    TRY(r1 >> skip(5) >> collect >> overwrite(v));               TEST_EQUAL(format_range(v), "[bb/x,bb/y,bb/z,cc/w,cc/x,cc/y,cc/z]");
+    TRY(s1 >> outer_product(""s) >> collect >> overwrite(m));    TEST_EQUAL(format_map(m), "{}");
+    TRY(""s >> outer_product(s2) >> collect >> overwrite(m));    TEST_EQUAL(format_map(m), "{}");
+
+    {
+        ParallelLimitsOverride limits(4, 1);
+        auto g = [] (int x, int y) { return x * 1000 + y; };
+        for (size_t n1: {0, 1, 7, 100}) {
+            for (size_t n2: {0, 1, 5, 9000}) {
+                std::vector<int> v1(n1), v2(n2), expect, result;
+                for (size_t i = 0; i < n1; ++i)
+                    v1[i] = int(i);
+                for (size_t i = 0; i < n2; ++i)
+                    v2[i] = int(i);
+                for (int x: v1)
+                    for (int y: v2)
+                        expect.push_back(g(x, y));
+                auto r2 = v1 >> outer_product(v2, g);
+                TRY(r2 >> collect >> overwrite(result));      TEST_EQUAL_RANGES(result, expect);
+                TRY(r2 >> par_collect >> overwrite(result));  TEST_EQUAL_RANGES(result, expect);
+                size_t k = n1 * n2 / 3;
+                TRY(r2 >> skip(k) >> collect >> overwrite(result));
+                TEST(std::equal(result.begin(), result.end(), expect.begin() + k, expect.end()));
+                long long total = 0, expect_total = 0;
+                for (int x: expect)
+                    expect_total += x;
+                TRY(total = r2 >> par_sum(0ll));  TEST_EQUAL(total, expect_total);
+                std::atomic<long long> each_total(0);
+                TRY(r2 >> par_each([&each_total] (int x) { each_total += x; }));
+                TEST_EQUAL(each_total.load(), expect_total);
+            }
+        }
+    }
+
 }
 
 void test_rs_range_combination_set_difference() {
@@ -222,6 +647,21 @@ void test_rs_range_combination_set_difference() {
     s1 = "uvwxyz";  s2 = "aeiou";   TRY(s1 << set_difference(s2));  TEST_EQUAL(s1, "vwxyz");
     s1 = "aeiou";   s2 = "uvwxyz";  TRY(s1 << set_difference(s2));  TEST_EQUAL(s1, "aeio");
 
+    ParallelLimitsOverride limits(4, 1);
+    std::vector<int> v1, v2, v3, v4;
+
+    for (size_t n: {0, 1, 10, 1000}) {
+        for (size_t m: {0, 1, 5, 777}) {
+            v1 = sorted_sample(n, 50, 1);
+            v2 = sorted_sample(m, 50, 2);
+            v4.clear();
+            std::set_difference(v1.begin(), v1.end(), v2.begin(), v2.end(), std::back_inserter(v4));
+            v3 = v1;
+            TRY(v3 << set_difference(v2));
+            TEST_EQUAL_RANGES(v3, v4);
+        }
+    }
+
 }
 
 void test_rs_range_combination_set_difference_from() {
@@ -260,6 +700,21 @@ void test_rs_range_combination_set_difference_from() {
     s1 = "uvwxyz";  s2 = "aeiou";   TRY(s1 << set_difference_from(s2));  TEST_EQUAL(s1, "aeio");
     s1 = "aeiou";   s2 = "uvwxyz";  TRY(s1 << set_difference_from(s2));  TEST_EQUAL(s1, "vwxyz");
 
+    ParallelLimitsOverride limits(4, 1);
+    std::vector<int> v1, v2, v3, v4;
+
+    for (size_t n: {0, 1, 10, 1000}) {
+        for (size_t m: {0, 1, 5, 777}) {
+            v1 = sorted_sample(n, 50, 1);
+            v2 = sorted_sample(m, 50, 2);
+            v4.clear();
+            std::set_difference(v2.begin(), v2.end(), v1.begin(), v1.end(), std::back_inserter(v4));
+            v3 = v1;
+            TRY(v3 << set_difference_from(v2));
+            TEST_EQUAL_RANGES(v3, v4);
+        }
+    }
+
 }
 
 void test_rs_range_combination_set_intersection() {
@@ -298,6 +753,21 @@ void test_rs_range_combination_set_intersection() {
     s1 = "uvwxyz";  s2 = "aeiou";   TRY(s1 << set_intersection(s2));  TEST_EQUAL(s1, "u");
     s1 = "aeiou";   s2 = "uvwxyz";  TRY(s1 << set_intersection(s2));  TEST_EQUAL(s1, "u");
 
+    ParallelLimitsOverride limits(4, 1);
+    std::vector<int> v1, v2, v3, v4;
+
+    for (size_t n: {0, 1, 10, 1000}) {
+        for (size_t m: {0, 1, 5, 777}) {
+            v1 = sorted_sample(n, 50, 1);
+            v2 = sorted_sample(m, 50, 2);
+            v4.clear();
+            std::set_intersection(v1.begin(), v1.end(), v2.begin(), v2.end(), std::back_inserter(v4));
+            v3 = v1;
+            TRY(v3 << set_intersection(v2));
+            TEST_EQUAL_RANGES(v3, v4);
+        }
+    }
+
 }
 
 void test_rs_range_combination_set_symmetric_difference() {
@@ -336,6 +806,21 @@ void test_rs_range_combination_set_symmetric_difference() {
     s1 = "uvwxyz";  s2 = "aeiou";   TRY(s1 << set_symmetric_difference(s2));  TEST_EQUAL(s1, "aeiovwxyz");
     s1 = "aeiou";   s2 = "uvwxyz";  TRY(s1 << set_symmetric_difference(s2));  TEST_EQUAL(s1, "aeiovwxyz");
 
+    ParallelLimitsOverride limits(4, 1);
+    std::vector<int> v1, v2, v3, v4;
+
+    for (size_t n: {0, 1, 10, 1000}) {
+        for (size_t m: {0, 1, 5, 777}) {
+            v1 = sorted_sample(n, 50, 1);
+            v2 = sorted_sample(m, 50, 2);
+            v4.clear();
+            std::set_symmetric_difference(v1.begin(), v1.end(), v2.begin(), v2.end(), std::back_inserter(v4));
+            v3 = v1;
+            TRY(v3 << set_symmetric_difference(v2));
+            TEST_EQUAL_RANGES(v3, v4);
+        }
+    }
+
 }
 
 void test_rs_range_combination_set_union() {
@@ -374,6 +859,95 @@ void test_rs_range_combination_set_union() {
     s1 = "uvwxyz";  s2 = "aeiou";   TRY(s1 << set_union(s2));  TEST_EQUAL(s1, "aeiouvwxyz");
     s1 = "aeiou";   s2 = "uvwxyz";  TRY(s1 << set_union(s2));  TEST_EQUAL(s1, "aeiouvwxyz");
 
+    ParallelLimitsOverride limits(4, 1);
+    std::vector<int> v1, v2, v3, v4;
+
+    for (size_t n: {0, 1, 10, 1000}) {
+        for (size_t m: {0, 1, 5, 777}) {
+            v1 = sorted_sample(n, 50, 1);
+            v2 = sorted_sample(m, 50, 2);
+            v4.clear();
+            std::set_union(v1.begin(), v1.end(), v2.begin(), v2.end(), std::back_inserter(v4));
+            v3 = v1;
+            TRY(v3 << set_union(v2));
+            TEST_EQUAL_RANGES(v3, v4);
+        }
+    }
+
+}
+
+void test_rs_range_combination_soa() {
+
+    struct Point {
+        int id;
+        double x;
+        std::string name;
+    };
+
+    std::vector<int> ids = {1, 2, 3, 4, 5};
+    std::vector<double> xs = {1.5, 2.5, 3.5, 4.5};
+    std::vector<std::string> names = {"one", "two", "three", "four", "five"};
+    std::vector<int> v;
+    std::vector<std::string> vs;
+    double d = 0;
+    int n = 0;
+
+    auto rows = soa(ids, xs, names);
+    TEST_EQUAL(rows.end() - rows.begin(), 4);
+    TEST_EQUAL(rows.begin()[2].get<0>(), 3);
+    TEST_EQUAL(rows.begin()[2].get<1>(), 3.5);
+    TEST_EQUAL(rows.begin()[2].get<2>(), "three");
+    TEST_EQUAL(get<2>(rows.begin()[3]), "four");
+    TEST_EQUAL(rows.begin()[3].index(), 3u);
+    TEST(rows.begin()[1].values() == std::make_tuple(2, 2.5, "two"s));
+
+    auto [i1, x1, s1] = rows.begin()[0];
+    TEST_EQUAL(i1, 1);
+    TEST_EQUAL(x1, 1.5);
+    TEST_EQUAL(s1, "one");
+
+    TRY(rows >> each([&] (auto& row) { n += row.template get<0>(); }));
+    TEST_EQUAL(n, 10);
+    TRY(rows >> filter([] (const auto& row) { return row.template get<0>() % 2 == 0; })
+        >> map([] (const auto& row) { return row.template get<2>(); }) >> overwrite(vs));
+    TEST_EQUAL(vs.size(), 2u);
+    TEST_EQUAL(vs[0], "two");
+    TEST_EQUAL(vs[1], "four");
+
+    TRY(d = rows >> column<1> >> sum);
+    TEST_EQUAL(d, 12.0);
+    TRY(rows >> column<0> >> overwrite(v));
+    TEST_EQUAL_RANGES(v, (std::vector<int>{1, 2, 3, 4}));
+    TRY(n = rows >> column<0> >> filter([] (int i) { return i > 1; }) >> count);
+    TEST_EQUAL(n, 3);
+    auto sub = Irange<decltype(rows.begin())>{rows.begin() + 1, rows.begin() + 3};
+    TRY(sub >> column<2> >> overwrite(vs));
+    TEST_EQUAL_RANGES(vs, (std::vector<std::string>{"two", "three"}));
+
+    std::vector<Point> points = {{1, 1.5, "one"}, {2, 2.5, "two"}, {3, 3.5, "three"}};
+
+    auto [pi, px] = points >> collect_soa(&Point::id, &Point::x);
+    TEST_EQUAL_RANGES(pi, (std::vector<int>{1, 2, 3}));
+    TEST_EQUAL_RANGES(px, (std::vector<double>{1.5, 2.5, 3.5}));
+    auto [pn, plen] = points >> collect_soa(&Point::name, [] (const Point& p) { return p.name.size(); });
+    TEST_EQUAL_RANGES(pn, (std::vector<std::string>{"one", "two", "three"}));
+    TEST_EQUAL_RANGES(plen, (std::vector<size_t>{3, 3, 5}));
+
+    std::vector<std::pair<int, std::string>> pairs = {{1, "a"}, {2, "b"}};
+    auto [c1, c2] = pairs >> collect_soa();
+    TEST_EQUAL_RANGES(c1, (std::vector<int>{1, 2}));
+    TEST_EQUAL_RANGES(c2, (std::vector<std::string>{"a", "b"}));
+
+    auto [r1, r2, r3] = rows >> collect_soa();
+    TEST_EQUAL_RANGES(r1, (std::vector<int>{1, 2, 3, 4}));
+    TEST_EQUAL_RANGES(r2, xs);
+    TEST_EQUAL_RANGES(r3, (std::vector<std::string>{"one", "two", "three", "four"}));
+
+    std::list<std::pair<int, int>> li = {{1, 2}, {3, 4}};
+    auto [l1, l2] = li >> collect_soa();
+    TEST_EQUAL_RANGES(l1, (std::vector<int>{1, 3}));
+    TEST_EQUAL_RANGES(l2, (std::vector<int>{2, 4}));
+
 }
 
 void test_rs_range_combination_zip() {
@@ -2,7 +2,9 @@
 #include "rs-format/string.hpp"
 #include "rs-tl/iterator.hpp"
 #include "rs-unit-test.hpp"
+#include "test/parallel-limits.hpp"
 #include <algorithm>
+#include <atomic>
 #include <forward_list>
 #include <iterator>
 #include <map>
@@ -223,6 +225,35 @@ void test_rs_range_core_each() {
 
 }
 
+void test_rs_range_core_parallel() {
+
+    ParallelLimitsOverride limits(4, 1);
+
+    std::vector<int> v(1000);
+    std::forward_list<int> fl = {1,2,3,4,5};
+    std::atomic<int> sum(0);
+    std::string s;
+
+    for (size_t i = 0; i < v.size(); ++i)
+        v[i] = int(i);
+
+    auto r1 = v >> par_collect;
+    TEST(std::equal(r1.begin(), r1.end(), v.begin(), v.end()));
+    auto r2 = fl >> par_collect;
+    TEST_EQUAL(format_range(r2), "[1,2,3,4,5]");
+
+    auto f = [&sum] (int x) { sum += x; };
+    TRY(v >> par_each(f));
+    TEST_EQUAL(sum.load(), 499500);
+    sum = 0;
+    TRY(v >> passthrough >> par_each(f));
+    TEST_EQUAL(sum.load(), 499500);
+    sum = 0;
+    TRY(fl >> par_each(f));
+    TEST_EQUAL(sum.load(), 15);
+
+}
+
 void test_rs_range_core_combinator() {
 
     std::string s;
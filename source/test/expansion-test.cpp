@@ -1,7 +1,15 @@
 #include "rs-range/expansion.hpp"
+#include "rs-range/permutation.hpp"
+#include "rs-range/selection.hpp"
 #include "rs-tl/iterator.hpp"
 #include "rs-unit-test.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <list>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -93,6 +101,40 @@ void test_rs_range_expansion_flat_map() {
     TRY("abcde"s >> passthrough * flat_map(f) * passthrough >> overwrite(s1));    TEST_EQUAL(s1, "abbcccddddeeeee");
     TRY(s2 << flat_map(f));                                                       TEST_EQUAL(s2, "abbcccddddeeeee");
 
+    auto g = [] (char c) { return std::string(c % 2 == 0 ? 0 : 2, c); };
+    TRY("abcde"s >> flat_map(g) >> overwrite(s1));  TEST_EQUAL(s1, "aaccee");
+    TRY("bd"s >> flat_map(g) >> overwrite(s1));     TEST_EQUAL(s1, "");
+
+    std::vector<std::string> words = {"alpha", "", "bravo", "charlie"};
+    auto view = [] (const std::string& w) -> const std::string& { return w; };
+    TRY(words >> flat_map(view) >> overwrite(s1));  TEST_EQUAL(s1, "alphabravocharlie");
+
+    std::vector<std::vector<int>> vv = {{1, 2, 3}, {}, {4, 5}};
+    auto sv = [] (const std::vector<int>& v) { return Irange<std::vector<int>::const_iterator>{v.begin(), v.end()}; };
+    std::vector<int> v;
+    TRY(vv >> flat_map(sv) >> overwrite(v));
+    TEST_EQUAL_RANGES(v, (std::vector<int>{1, 2, 3, 4, 5}));
+
+    s2 = "abcde";
+    auto r = s2 >> flat_map(f);
+    auto i = r.begin();
+    TRY(std::advance(i, 4));
+    TEST_EQUAL(*i, 'c');
+    auto j = i;
+    TRY(++i);
+    TEST_EQUAL(*i, 'c');
+    TEST_EQUAL(*j, 'c');
+    TEST(i != j);
+    TRY(++j);
+    TEST(i == j);
+    TRY(std::advance(i, 2));
+    TEST_EQUAL(*i, 'd');
+    auto k = std::move(j);
+    TRY(j = i);
+    TEST_EQUAL(*j, 'd');
+    TEST_EQUAL(*k, 'c');
+    TEST_EQUAL(std::distance(r.begin(), r.end()), 15);
+
 }
 
 void test_rs_range_expansion_flatten() {
@@ -104,6 +146,73 @@ void test_rs_range_expansion_flatten() {
     TRY(v >> passthrough >> flatten >> passthrough >> overwrite(s));  TEST_EQUAL(s, "AlphaBravoCharlieDeltaEcho");
     TRY(v >> passthrough * flatten * passthrough >> overwrite(s));    TEST_EQUAL(s, "AlphaBravoCharlieDeltaEcho");
 
+    std::vector<std::vector<int>> nest = {{}, {1, 2, 3}, {}, {}, {4}, {5, 6}, {}};
+    std::vector<std::vector<int>> empties = {{}, {}, {}};
+    std::vector<int> iv;
+    size_t n = 0;
+    int total = 0;
+
+    TRY(n = nest >> flatten >> count);                             TEST_EQUAL(n, 6u);
+    TRY(n = nest >> flatten >> count(3));                          TEST_EQUAL(n, 1u);
+    TRY(n = nest >> flatten >> count_if([] (int x) { return x % 2 == 0; }));  TEST_EQUAL(n, 3u);
+    TRY(total = nest >> flatten >> sum);                           TEST_EQUAL(total, 21);
+    TRY(total = nest >> flatten >> sum(100));                      TEST_EQUAL(total, 121);
+    TRY(nest >> flatten >> collect >> overwrite(iv));              TEST_EQUAL(iv.size(), 6u);  TEST_EQUAL_RANGES(iv, (std::vector<int>{1, 2, 3, 4, 5, 6}));
+    iv.clear();  TRY(nest >> flatten >> append(iv));               TEST_EQUAL_RANGES(iv, (std::vector<int>{1, 2, 3, 4, 5, 6}));
+    TRY(nest >> flatten >> append(iv));                            TEST_EQUAL_RANGES(iv, (std::vector<int>{1, 2, 3, 4, 5, 6, 1, 2, 3, 4, 5, 6}));
+    total = 0;  TRY(nest >> flatten >> each([&total] (int x) { total = 10 * total + x; }));  TEST_EQUAL(total, 123456);
+    TRY(n = empties >> flatten >> count);                          TEST_EQUAL(n, 0u);
+    TRY(empties >> flatten >> collect >> overwrite(iv));           TEST(iv.empty());
+    TRY(n = std::vector<std::vector<int>>() >> flatten >> count);  TEST_EQUAL(n, 0u);
+
+    TRY(n = v >> flatten >> count('a'));  TEST_EQUAL(n, 4u);
+    TRY(v >> flatten >> collect >> overwrite(s));  TEST_EQUAL(s, "AlphaBravoCharlieDeltaEcho");
+
+    auto rv = v >> indexed_flatten;
+    auto rn = nest >> indexed_flatten;
+    auto re = empties >> indexed_flatten;
+
+    TRY(rv >> overwrite(s));                        TEST_EQUAL(s, "AlphaBravoCharlieDeltaEcho");
+    TRY(rv >> reverse >> overwrite(s));             TEST_EQUAL(s, "ohcEatleDeilrahCovarBahplA");
+    TRY(rv >> skip(7) >> overwrite(s));             TEST_EQUAL(s, "avoCharlieDeltaEcho");
+    TRY(v >> passthrough >> indexed_flatten >> passthrough >> overwrite(s));  TEST_EQUAL(s, "AlphaBravoCharlieDeltaEcho");
+    TEST_EQUAL(rv.end() - rv.begin(), 26);
+    TEST_EQUAL(rv.begin()[0], 'A');
+    TEST_EQUAL(rv.begin()[5], 'B');
+    TEST_EQUAL(rv.begin()[12], 'a');
+    TEST_EQUAL(rv.begin()[25], 'o');
+    TEST_EQUAL((rv.begin() + 17).segment(), 3u);
+    TEST_EQUAL((rv.begin() + 17).offset(), 0u);
+    TEST_EQUAL(*(rv.end() - 1), 'o');
+    TEST(rv.begin() + 26 == rv.end());
+    TEST(rv.begin() + 10 < rv.begin() + 11);
+
+    TEST_EQUAL(rn.end() - rn.begin(), 6);
+    TRY(rn >> overwrite(iv));             TEST_EQUAL_RANGES(iv, (std::vector<int>{1, 2, 3, 4, 5, 6}));
+    TRY(rn >> reverse >> overwrite(iv));  TEST_EQUAL_RANGES(iv, (std::vector<int>{6, 5, 4, 3, 2, 1}));
+    for (int i = 0; i < 6; ++i)
+        TEST_EQUAL(rn.begin()[i], i + 1);
+    for (int i = 0; i <= 6; ++i)
+        for (int j = 0; j <= 6; ++j)
+            TEST_EQUAL((rn.begin() + i) - (rn.end() - j), i + j - 6);
+    TRY(total = rn >> par_sum);  TEST_EQUAL(total, 21);
+    TEST(re.begin() == re.end());
+    TRY(re >> overwrite(iv));    TEST(iv.empty());
+
+    std::vector<std::vector<int>> ragged;
+    for (int i = 0; i < 1000; ++i)
+        ragged.push_back(std::vector<int>(i % 7 == 3 ? 0 : i % 50, i));
+    auto rr = ragged >> indexed_flatten;
+    std::atomic<int64_t> big(0);
+    int64_t expect = 0;
+    for (auto& inner: ragged)
+        for (auto x: inner)
+            expect += x;
+    TRY(rr >> par_each([&big] (int x) { big += x; }));
+    TEST_EQUAL(big.load(), expect);
+    TEST_EQUAL(rr >> par_sum(int64_t(0)), expect);
+    TEST_EQUAL(size_t(rr.end() - rr.begin()), ragged >> flatten >> count);
+
 }
 
 void test_rs_range_expansion_insert_algorithms() {
@@ -136,6 +245,77 @@ void test_rs_range_expansion_insert_algorithms() {
 
 }
 
+void test_rs_range_expansion_mask_subsets() {
+
+    std::string s = "abcd", t;
+    auto show = [&] (const SubsetMask& m) {
+        std::string u;
+        for (auto i: m)
+            u += s[i];
+        t += (u.empty() ? "-"s : u) + " ";
+    };
+
+    TRY(s >> mask_subsets >> each(show));
+    TEST_EQUAL(t, "- a ab b bc abc ac c cd acd abcd bcd bd abd ad d ");
+
+    t.clear();
+    TRY(s >> mask_subsets(2) >> each(show));
+    TEST_EQUAL(t, "ab ac bc ad bd cd ");
+    t.clear();
+    TRY(s >> mask_subsets(0) >> each(show));
+    TEST_EQUAL(t, "- ");
+    t.clear();
+    TRY(s >> mask_subsets(5) >> each(show));
+    TEST_EQUAL(t, "");
+    t.clear();
+    TRY(""s >> mask_subsets >> each(show));
+    TEST_EQUAL(t, "- ");
+
+    auto g = s >> mask_subsets;
+    auto i = g.begin();
+    TEST_EQUAL(g.end() - g.begin(), 16);
+    TEST_EQUAL((*i).mask(), 0u);  TEST_EQUAL(i.changed(), npos);
+    TRY(++i);  TEST_EQUAL((*i).mask(), 1u);  TEST_EQUAL(i.changed(), 0u);
+    TRY(++i);  TEST_EQUAL((*i).mask(), 3u);  TEST_EQUAL(i.changed(), 1u);
+    TRY(i += 10);  TEST_EQUAL((*i).mask(), 10u);  TEST_EQUAL(i.changed(), 2u);  TEST_EQUAL(i.rank(), 12u);
+    TEST_EQUAL(gray_code_rank(10), 12u);
+    TEST_EQUAL((*i).size(), 2u);
+    TEST(! (*i).contains(0));
+    TEST((*i).contains(1));
+    TEST((*i).contains(3));
+    TEST(! (*i).contains(64));
+
+    std::vector<int> v(40);
+    auto f = v >> mask_subsets(20);
+    TEST_EQUAL(f.end() - f.begin(), 137846528820);
+    auto j = f.begin() + 100000000000;
+    TEST_EQUAL(j.rank(), 100000000000u);
+    TEST_EQUAL((*j).size(), 20u);
+    TEST_EQUAL(mask_subset_rank((*j).mask()), 100000000000u);
+    uint64_t m = (*j).mask();
+    TRY(++j);
+    TEST((*j).mask() > m);
+    TEST_EQUAL(mask_subset_rank((*j).mask()), 100000000001u);
+
+    std::vector<int> w(64);
+    auto last = (w >> mask_subsets(32)).end() - 1;
+    TEST_EQUAL((*last).mask(), 0xffffffff00000000ull);
+    TRY(w >> mask_subsets(64));
+    TRY(std::vector<int>(62) >> mask_subsets);
+    TEST_THROW(w >> mask_subsets, std::length_error);
+    TEST_THROW(std::vector<int>(65) >> mask_subsets(1), std::length_error);
+
+    std::atomic<size_t> total(0), bits(0);
+    std::vector<int> u(16);
+    TRY(u >> mask_subsets >> par_each([&] (const SubsetMask& sm) {
+        total += 1;
+        bits += sm.size();
+    }));
+    TEST_EQUAL(total.load(), 65536u);
+    TEST_EQUAL(bits.load(), 65536u * 8);
+
+}
+
 void test_rs_range_expansion_permutations() {
 
     std::string s;
@@ -157,6 +337,77 @@ void test_rs_range_expansion_permutations() {
         "adcb;adbc;acdb;acbd;abdc;abcd;"
     );
 
+    s.clear();
+    TRY("abcd"s >> heap_permutations >> each([&] (auto& x) { s.append(x.begin(), x.end()); s += ";"; }));
+    TEST_EQUAL(s,
+        "abcd;bacd;cabd;acbd;bcad;cbad;"
+        "dbac;bdac;adbc;dabc;badc;abdc;"
+        "acdb;cadb;dacb;adcb;cdab;dcab;"
+        "dcba;cdba;bdca;dbca;cbda;bcda;"
+    );
+
+    s.clear();
+    TRY(""s >> heap_permutations >> each([&] (auto& x) { s.append(x.begin(), x.end()); s += ";"; }));
+    TEST_EQUAL(s, "");
+    TRY("a"s >> heap_permutations >> each([&] (auto& x) { s.append(x.begin(), x.end()); s += ";"; }));
+    TEST_EQUAL(s, "a;");
+
+    std::string t = "abc";
+    auto hr = t >> heap_permutations;
+    auto hi = hr.begin();
+    std::string prev;
+    size_t count = 0;
+    TEST_EQUAL(hi.swapped().first, npos);
+    TEST_EQUAL(hi.swapped().second, npos);
+    for (; hi != hr.end(); ++hi, ++count) {
+        TEST_EQUAL(hi.rank(), count);
+        if (count > 0) {
+            std::swap(prev[hi.swapped().first], prev[hi.swapped().second]);
+            TEST_EQUAL(std::string((*hi).begin(), (*hi).end()), prev);
+        }
+        prev.assign((*hi).begin(), (*hi).end());
+    }
+    TEST_EQUAL(count, 6u);
+
+    s.clear();
+    TRY("abcd"s >> lex_permutations >> each([&] (auto& x) { s.append(x.begin(), x.end()); s += ";"; }));
+    TEST_EQUAL(s,
+        "abcd;abdc;acbd;acdb;adbc;adcb;"
+        "bacd;badc;bcad;bcda;bdac;bdca;"
+        "cabd;cadb;cbad;cbda;cdab;cdba;"
+        "dabc;dacb;dbac;dbca;dcab;dcba;"
+    );
+
+    s.clear();
+    TRY(""s >> lex_permutations >> each([&] (auto& x) { s.append(x.begin(), x.end()); s += ";"; }));
+    TEST_EQUAL(s, "");
+
+    t = "abcdefghij";
+    auto lr = t >> lex_permutations;
+    TEST_EQUAL(lr.end() - lr.begin(), 3628800);
+    auto li = lr.begin() + 1000000;
+    TEST_EQUAL(std::string((*li).begin(), (*li).end()), "chidjbfgae");
+    TEST_EQUAL(li.rank(), 1000000u);
+    TEST_EQUAL(permutation_rank(li.indices()), 1000000u);
+    TRY(++li);
+    TEST_EQUAL(std::string((*li).begin(), (*li).end()), "chidjbfgea");
+    TRY(--li);
+    TEST_EQUAL(std::string((*li).begin(), (*li).end()), "chidjbfgae");
+    auto last = lr.begin()[3628799];
+    TEST_EQUAL(std::string(last.begin(), last.end()), "jihgfedcba");
+    TEST_EQUAL(permutation_rank({0, 1, 2}), 0u);
+    TEST_EQUAL(permutation_rank({2, 1, 0}), 5u);
+    TEST_THROW(std::vector<int>(21) >> lex_permutations, std::length_error);
+    TRY(std::vector<int>(20) >> lex_permutations);
+
+    std::atomic<size_t> total(0), sum(0);
+    TRY("abcdefg"s >> lex_permutations >> par_each([&] (auto& x) {
+        total += 1;
+        sum += x[0] - 'a';
+    }));
+    TEST_EQUAL(total.load(), 5040u);
+    TEST_EQUAL(sum.load(), 720u * 21);
+
 }
 
 void test_rs_range_expansion_repeat() {
@@ -214,6 +465,118 @@ void test_rs_range_expansion_repeat() {
     TRY(++i);  TEST_EQUAL(*i, 'o');  TEST_EQUAL(i - r.begin(), 14);  TEST_EQUAL(i - r.end(), -1);   TRY(j = r.begin());  TRY(j += 14);  TEST(i == j);  TEST_EQUAL(*j, 'o');
     TRY(++i);  /**/                  TEST_EQUAL(i - r.begin(), 15);  TEST_EQUAL(i - r.end(), 0);    TRY(j = r.begin());  TRY(j += 15);  TEST(i == j);  /**/
 
+    std::vector<int> v = {1, 2, 3, 4}, w;
+    std::vector<std::string> sv = {"a", "bc"};
+    size_t n = 0;
+    int total = 0;
+
+    TRY(n = v >> repeat(1000) >> count);                                        TEST_EQUAL(n, 4000u);
+    TRY(n = v >> repeat(1000) >> count(3));                                     TEST_EQUAL(n, 1000u);
+    TRY(n = v >> repeat(1000) >> count_if([] (int x) { return x % 2 == 0; }));  TEST_EQUAL(n, 2000u);
+    TRY(total = v >> repeat(1000) >> sum);                                      TEST_EQUAL(total, 10000);
+    TRY(total = v >> repeat(3) >> sum(5));                                      TEST_EQUAL(total, 35);
+    TRY(total = v >> repeat(0) >> sum);                                         TEST_EQUAL(total, 0);
+    TRY(n = std::vector<int>() >> repeat(5) >> count);                          TEST_EQUAL(n, 0u);
+    TRY(n = std::vector<int>() >> repeat >> take(5) >> count);                  TEST_EQUAL(n, 0u);
+    TRY(v >> repeat(3) >> collect >> overwrite(w));                             TEST_EQUAL_RANGES(w, (std::vector<int>{1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4}));
+    TRY(v >> repeat >> take(10) >> collect >> overwrite(w));                    TEST_EQUAL_RANGES(w, (std::vector<int>{1, 2, 3, 4, 1, 2, 3, 4, 1, 2}));
+    TRY(v >> repeat >> take(3) >> collect >> overwrite(w));                     TEST_EQUAL_RANGES(w, (std::vector<int>{1, 2, 3}));
+    TRY(v >> repeat(2) >> take(100) >> collect >> overwrite(w));                TEST_EQUAL_RANGES(w, (std::vector<int>{1, 2, 3, 4, 1, 2, 3, 4}));
+    TRY(total = v >> repeat >> take(10) >> sum);                                TEST_EQUAL(total, 23);
+    TRY(n = v >> repeat >> take(10) >> count(4));                               TEST_EQUAL(n, 2u);
+    TEST_THROW(v >> repeat >> count, std::length_error);
+    TEST_THROW(v >> repeat >> count(4), std::length_error);
+    TEST_THROW(v >> repeat >> collect, std::length_error);
+    w = v;  TEST_THROW(w << repeat, std::length_error);                         TEST_EQUAL(w.size(), 4u);
+    w = v;  TEST_THROW(w << repeat(size_t(1) << 62), std::length_error);        TEST_EQUAL(w.size(), 4u);
+    std::list<int> lw = {1, 2};  TEST_THROW(lw << repeat, std::length_error);
+    w.clear();  TRY(w << repeat);                                               TEST(w.empty());
+    TEST_EQUAL((v >> repeat).end() - (v >> repeat).begin(), std::numeric_limits<ptrdiff_t>::max());
+    TEST_EQUAL((v >> repeat).begin() - (v >> repeat).end(), std::numeric_limits<ptrdiff_t>::min());
+    w = v;  TRY(w << repeat(5));                                                TEST_EQUAL(w.size(), 20u);  TEST_EQUAL(w[19], 4);  TEST_EQUAL(w >> sum, 50);
+    TRY(sv >> repeat(3) >> collect >> overwrite(sv));                           TEST_EQUAL(sv.size(), 6u);  TEST_EQUAL(sv[5], "bc");
+    TRY(sv << repeat(2));                                                       TEST_EQUAL(sv.size(), 12u);  TEST_EQUAL(sv[11], "bc");
+    TRY("xyz"s >> repeat >> take(7) >> collect >> overwrite(s));               TEST_EQUAL(s, "xyzxyzx");
+
+    auto rt = v >> repeat >> take(9);
+    auto k = rt.begin();
+    TRY(k += 6);  TEST_EQUAL(*k, 3);  TEST_EQUAL(k.cycle(), 1);  TEST_EQUAL(k.index(), 2);
+    TRY(k -= 5);  TEST_EQUAL(*k, 2);  TEST_EQUAL(k.cycle(), 0);
+    TRY(k += 7);  TEST_EQUAL(*k, 1);  TEST_EQUAL(k.cycle(), 2);  TEST(k + 1 == rt.end());
+
+}
+
+void test_rs_range_expansion_revolving_door() {
+
+    std::string s = "abcde";
+    std::string t;
+    auto r = s >> revolving_door(3);
+    auto i = r.begin();
+
+    TEST_EQUAL(r.end() - r.begin(), 10);
+    TRY(r >> each([&] (auto& v) {
+        for (auto x: v)
+            t += s[x];
+        t += ' ';
+    }));
+    TEST_EQUAL(t, "abc acd bcd abd ade bde cde ace bce abe ");
+
+    TEST_EQUAL_RANGES(*i, (std::vector<size_t>{0, 1, 2}));  TEST_EQUAL(i.rank(), 0u);  TEST_EQUAL(i.added(), npos);  TEST_EQUAL(i.removed(), npos);
+    TRY(++i);  TEST_EQUAL_RANGES(*i, (std::vector<size_t>{0, 2, 3}));  TEST_EQUAL(i.rank(), 1u);  TEST_EQUAL(i.added(), 3u);  TEST_EQUAL(i.removed(), 1u);
+    TRY(++i);  TEST_EQUAL_RANGES(*i, (std::vector<size_t>{1, 2, 3}));  TEST_EQUAL(i.rank(), 2u);  TEST_EQUAL(i.added(), 1u);  TEST_EQUAL(i.removed(), 0u);
+    TRY(i += 5);  TEST_EQUAL_RANGES(*i, (std::vector<size_t>{0, 2, 4}));  TEST_EQUAL(i.rank(), 7u);  TEST_EQUAL(i.added(), 0u);  TEST_EQUAL(i.removed(), 3u);
+    TRY(--i);  TEST_EQUAL_RANGES(*i, (std::vector<size_t>{2, 3, 4}));  TEST_EQUAL(i.rank(), 6u);  TEST_EQUAL(i.added(), 2u);  TEST_EQUAL(i.removed(), 1u);
+    TEST_EQUAL(i - r.begin(), 6);
+    TEST_EQUAL_RANGES(r.begin()[9], (std::vector<size_t>{0, 1, 4}));
+
+    auto j = r.begin(), k = j;
+    TRY(k = j);
+    TRY(++j);
+    TEST_EQUAL_RANGES(*k, (std::vector<size_t>{0, 1, 2}));
+    TEST_EQUAL_RANGES(*j, (std::vector<size_t>{0, 2, 3}));
+
+    for (int n = 0; n <= 12; ++n) {
+        for (int m = 0; m <= n + 1; ++m) {
+            std::vector<int> v(n);
+            auto rd = v >> revolving_door(m);
+            TEST_EQUAL(rd.end() - rd.begin(), binomial(n, m));
+            size_t count = 0;
+            for (auto p = rd.begin(); p != rd.end(); ++p, ++count) {
+                TEST_EQUAL(revolving_door_rank(*p), count);
+                if (count > 0) {
+                    TEST_EQUAL(std::count((*p).begin(), (*p).end(), p.added()), 1);
+                    TEST_EQUAL(std::count((*p).begin(), (*p).end(), p.removed()), 0);
+                }
+            }
+            TEST_EQUAL(count, size_t(binomial(n, m)));
+        }
+    }
+
+    TEST_EQUAL(revolving_door_rank({0, 1, 2}), 0u);
+    TEST_EQUAL(revolving_door_rank({0, 1, 4}), 9u);
+    TEST_THROW(std::vector<int>(70) >> revolving_door(35), std::length_error);
+    TEST_THROW(std::vector<int>(68) >> revolving_door(34), std::length_error);
+    TEST_THROW(std::vector<int>(67) >> revolving_door(33), std::length_error);
+    TRY(std::vector<int>(66) >> revolving_door(33));
+
+    std::vector<int> big(40);
+    auto rb = big >> revolving_door(20);
+    TEST_EQUAL(rb.end() - rb.begin(), 137846528820);
+    auto p = rb.begin() + 123456789012;
+    TEST_EQUAL(p.rank(), 123456789012u);
+    TEST_EQUAL(revolving_door_rank(*p), 123456789012u);
+    TRY(++p);
+    TEST_EQUAL(revolving_door_rank(*p), 123456789013u);
+
+    std::atomic<size_t> total(0), sum(0);
+    std::vector<int> v(12);
+    TRY(v >> revolving_door(5) >> par_each([&] (auto& c) {
+        total += 1;
+        sum += revolving_door_rank(c);
+    }));
+    TEST_EQUAL(total.load(), 792u);
+    TEST_EQUAL(sum.load(), 792u * 791 / 2);
+
 }
 
 void test_rs_range_expansion_subsets() {
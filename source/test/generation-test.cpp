@@ -1,11 +1,26 @@
 #include "rs-range/generation.hpp"
+#include "rs-range/reduction.hpp"
 #include "rs-range/selection.hpp"
+#include "rs-range/transformation.hpp"
 #include "rs-format/string.hpp"
 #include "rs-tl/iterator.hpp"
 #include "rs-unit-test.hpp"
+#include "test/parallel-limits.hpp"
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <list>
+#include <memory>
 #include <random>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
 using namespace RS::Format;
@@ -16,6 +31,15 @@ using namespace std::literals;
 
 namespace {
 
+    // Always returns its largest value, to probe the top end of a distribution
+
+    struct MaxEngine {
+        using result_type = uint64_t;
+        static constexpr uint64_t min() noexcept { return 0; }
+        static constexpr uint64_t max() noexcept { return ~ uint64_t(0); }
+        uint64_t operator()() noexcept { return max(); }
+    };
+
     template <typename Range>
     void stats(const Range& r, double& mean, double& sd) {
         double n = 0, sum = 0, sum2 = 0;
@@ -29,6 +53,58 @@ namespace {
         sd = std::sqrt(sum2 / n - mean * mean);
     }
 
+    #ifdef RS_RANGE_COROUTINES
+
+        Generator<int> count_to(int n) {
+            for (int i = 1; i <= n; ++i)
+                co_yield i;
+        }
+
+        struct Node {
+            int value;
+            std::vector<Node> children;
+        };
+
+        Generator<int> walk(const Node& node) {
+            co_yield node.value;
+            for (auto& child: node.children)
+                co_yield elements_of(walk(child));
+        }
+
+        Generator<int> nested(int depth) {
+            if (depth > 0)
+                co_yield elements_of(nested(depth - 1));
+            co_yield depth;
+        }
+
+        struct Arena {
+            std::vector<unsigned char> storage = std::vector<unsigned char>(4096);
+            size_t used = 0;
+            int live = 0;
+        };
+
+        template <typename T>
+        struct ArenaAllocator {
+            using value_type = T;
+            Arena* arena;
+            explicit ArenaAllocator(Arena& a) noexcept: arena(&a) {}
+            template <typename U> ArenaAllocator(const ArenaAllocator<U>& a) noexcept: arena(a.arena) {}
+            T* allocate(size_t n) {
+                auto ptr = arena->storage.data() + arena->used;
+                arena->used += n * sizeof(T);
+                ++arena->live;
+                return reinterpret_cast<T*>(ptr);
+            }
+            void deallocate(T*, size_t) noexcept { --arena->live; }
+        };
+
+        Generator<int, ArenaAllocator<std::byte>> arena_count(std::allocator_arg_t, ArenaAllocator<std::byte>, int n) {
+            for (int i = 1; i <= n; ++i)
+                co_yield i;
+        }
+
+    #endif
+
 }
 
 void test_rs_range_generation_epsilon() {
@@ -65,6 +141,24 @@ void test_rs_range_generation_fill() {
     s.resize(4);  TRY(s << fill('x'));  TEST_EQUAL(s, "xxxx");
     s.resize(5);  TRY(s << fill('x'));  TEST_EQUAL(s, "xxxxx");
 
+    std::vector<int> vi(1000, 1);
+    std::vector<double> vd(1000);
+    std::vector<std::string> vs(10);
+    std::list<int> li(10);
+
+    TRY(vi << fill(0));     TEST(std::all_of(vi.begin(), vi.end(), [] (int x) { return x == 0; }));
+    TRY(vi << fill(-1));    TEST(std::all_of(vi.begin(), vi.end(), [] (int x) { return x == -1; }));
+    TRY(vi << fill(42));    TEST(std::all_of(vi.begin(), vi.end(), [] (int x) { return x == 42; }));
+    TRY(vd << fill(1.5));   TEST(std::all_of(vd.begin(), vd.end(), [] (double x) { return x == 1.5; }));
+    TRY(vs << fill("xyz"s));  TEST(std::all_of(vs.begin(), vs.end(), [] (auto& x) { return x == "xyz"; }));
+    TRY(li << fill(99));    TEST(std::all_of(li.begin(), li.end(), [] (int x) { return x == 99; }));
+
+    auto r = fill('x', 10);
+    TEST_EQUAL(r.end() - r.begin(), 10);
+    TEST_EQUAL(r.begin() - r.end(), -10);
+    TEST((r.begin() + 10 == r.end()));
+    TEST((r.end() - 10 == r.begin()));
+
 }
 
 void test_rs_range_generation_generate() {
@@ -94,6 +188,70 @@ void test_rs_range_generation_generate() {
     n = 0;  s.resize(4);  TRY(s << generate(f));  TEST_EQUAL(s, "abcd");
     n = 0;  s.resize(5);  TRY(s << generate(f));  TEST_EQUAL(s, "abcde");
 
+    std::vector<int> v(1000);
+    std::list<int> l(5);
+    int k = 0;
+    auto g = [&k] { return k++; };
+
+    TRY(v << generate(g));
+    TEST_EQUAL(k, 1000);
+    TEST_EQUAL(v.front(), 0);
+    TEST_EQUAL(v.back(), 999);
+    k = 0;
+    TRY(l << generate(g));
+    TEST_EQUAL(k, 5);
+    TEST_EQUAL(format_range(l), "[0,1,2,3,4]");
+
+}
+
+void test_rs_range_generation_generator() {
+
+    #ifdef RS_RANGE_COROUTINES
+
+        std::vector<int> v;
+
+        TRY(count_to(0) >> overwrite(v));
+        TEST_EQUAL(v.size(), 0u);
+        TRY(count_to(5) >> overwrite(v));
+        TEST_EQUAL(format_range(v), "[1,2,3,4,5]");
+        TRY(count_to(10) >> map([] (int x) { return x * x; }) >> filter([] (int x) { return x % 2 == 0; }) >> overwrite(v));
+        TEST_EQUAL(format_range(v), "[4,16,36,64,100]");
+        TEST_EQUAL(count_to(100) >> sum, 5050);
+
+        auto g = count_to(3);
+        auto gi = g.begin();
+        TEST_EQUAL(*gi, 1);
+        TEST_EQUAL(*g.begin(), 1);
+        TRY(++gi);
+        TRY(++gi);
+        TRY(++gi);
+        TEST(gi == g.end());
+        TEST(g.begin() == g.end());
+
+        Node tree = {1, {{2, {{3, {}}, {4, {}}}}, {5, {}}, {6, {{7, {{8, {}}}}}}}};
+        TRY(walk(tree) >> overwrite(v));
+        TEST_EQUAL(format_range(v), "[1,2,3,4,5,6,7,8]");
+
+        TRY(nested(10000) >> overwrite(v));
+        TEST_EQUAL(v.size(), 10001u);
+        TEST_EQUAL(v.front(), 0);
+        TEST_EQUAL(v.back(), 10000);
+
+        Arena arena;
+        ArenaAllocator<std::byte> alloc(arena);
+
+        {
+            auto g = arena_count(std::allocator_arg, alloc, 5);
+            TEST_EQUAL(arena.live, 1);
+            TEST(arena.used > 0u);
+            TRY(g >> overwrite(v));
+            TEST_EQUAL(format_range(v), "[1,2,3,4,5]");
+        }
+
+        TEST_EQUAL(arena.live, 0);
+
+    #endif
+
 }
 
 void test_rs_range_generation_iota() {
@@ -115,6 +273,128 @@ void test_rs_range_generation_iota() {
     TRY(s << iota('a', char(2)));  TEST_EQUAL(s, "acegikmoqs");
     TRY(s << iota('a', f));        TEST_EQUAL(s, "aBcDeFgHiJ");
 
+    std::vector<int> v;
+    std::vector<double> d;
+    auto r = iota(10, 3, 20);
+    auto i = r.begin();
+
+    TEST_EQUAL(r.end() - r.begin(), 20);
+    TEST_EQUAL(i[0], 10);
+    TEST_EQUAL(i[19], 67);
+    TRY(i += 5);   TEST_EQUAL(*i, 25);  TEST_EQUAL(i.index(), 5u);
+    TRY(i -= 2);   TEST_EQUAL(*i, 19);
+    TRY(--i);      TEST_EQUAL(*i, 16);
+    TEST_EQUAL(*(r.end() - 1), 67);
+    TRY(r >> skip(15) >> overwrite(v));    TEST_EQUAL_RANGES(v, (std::vector<int>{55, 58, 61, 64, 67}));
+    TRY(iota(5, -2, 5) >> overwrite(v));   TEST_EQUAL_RANGES(v, (std::vector<int>{5, 3, 1, -1, -3}));
+    TRY(iota(0.5, 0.25, 4) >> overwrite(d));  TEST_EQUAL_RANGES(d, (std::vector<double>{0.5, 0.75, 1.0, 1.25}));
+    d.assign(3, 0.0);
+    TRY(d << iota(1.0, 0.5));  TEST_EQUAL_RANGES(d, (std::vector<double>{1.0, 1.5, 2.0}));
+    TEST_EQUAL(iota(1, 1, 100) >> map([] (int x) { return x * x; }) >> par_sum, 338350);
+    TEST_EQUAL(iota(0) >> skip(1000000) >> take(3) >> sum, 3000003);
+    auto unbounded = iota(0);
+    TEST_EQUAL(unbounded.end() - unbounded.begin(), std::numeric_limits<ptrdiff_t>::max());
+    TEST_EQUAL(unbounded.begin() - unbounded.end(), - std::numeric_limits<ptrdiff_t>::max());
+    TEST_EQUAL((unbounded.begin() + 10) - unbounded.begin(), 10);
+
+}
+
+void test_rs_range_generation_lines() {
+
+    std::vector<std::string_view> v;
+    std::string text = "alpha\nbravo\r\n\ncharlie\n\rdelta";
+    std::string s;
+
+    TRY(lines("") >> overwrite(v));                TEST_EQUAL(v.size(), 0u);
+    TRY(lines("\n") >> overwrite(v));              TEST_EQUAL(v.size(), 1u);  TEST(v[0].empty());
+    TRY(lines("abc") >> overwrite(v));             TEST_EQUAL(format_range(v), "[abc]");
+    TRY(lines("abc\n") >> overwrite(v));           TEST_EQUAL(format_range(v), "[abc]");
+    TRY(lines("abc\n\n") >> overwrite(v));         TEST_EQUAL(v.size(), 2u);
+    TRY(lines(text) >> overwrite(v));              TEST_EQUAL(format_range(v), "[alpha,bravo,,charlie,\rdelta]");
+    TEST_EQUAL(lines(text) >> count, 5u);
+    TEST_EQUAL(lines(text) >> filter([] (std::string_view x) { return ! x.empty(); }) >> count, 4u);
+
+    for (size_t buffer_size: {1, 4, 100}) {
+        std::istringstream in(text);
+        s.clear();
+        for (auto line: lines(in, buffer_size))
+            s += "[" + std::string(line) + "]";
+        TEST_EQUAL(s, "[alpha][bravo][][charlie][\rdelta]");
+    }
+
+    std::istringstream in2(text + "\n");
+    TEST_EQUAL(lines(in2) >> map([] (std::string_view x) { return x.size(); }) >> sum, 23u);
+
+    #ifdef RS_RANGE_FILE_DESCRIPTORS
+
+        int fds[2];
+        TEST_EQUAL(::pipe(fds), 0);
+        TEST_EQUAL(::write(fds[1], text.data(), text.size()), ptrdiff_t(text.size()));
+        ::close(fds[1]);
+        s.clear();
+        for (auto line: lines(fds[0], 8))
+            s += "[" + std::string(line) + "]";
+        ::close(fds[0]);
+        TEST_EQUAL(s, "[alpha][bravo][][charlie][\rdelta]");
+
+    #endif
+
+}
+
+void test_rs_range_generation_mapped_range() {
+
+    #ifdef RS_RANGE_MAPPED_FILES
+
+        struct Record {
+            int32_t id;
+            double value;
+        };
+
+        static constexpr int n = 10000;
+        const std::string path = "__mapped_range_test__";
+        std::vector<Record> records;
+
+        for (int i = 0; i < n; ++i)
+            records.push_back({i, i * 0.5});
+
+        {
+            std::ofstream out(path, std::ios::binary);
+        }
+
+        TRY(mapped_range<Record>(path) >> passthrough >> collect);
+        TEST((mapped_range<Record>(path) >> count) == 0u);
+
+        {
+            std::ofstream out(path, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(records.data()), std::streamsize(n * sizeof(Record)));
+            out.write("xyz", 3);
+        }
+
+        auto r = mapped_range<Record>(path, MapHint::sequential | MapHint::willneed | MapHint::huge_pages);
+        TEST_EQUAL(r.end() - r.begin(), n);
+        TEST_EQUAL(r.begin()[1234].id, 1234);
+        TEST_EQUAL((r.end() - 1)->value, 4999.5);
+        TEST_EQUAL(r >> map([] (const Record& x) { return x.id; }) >> sum, n * (n - 1) / 2);
+        TEST_EQUAL(r >> filter([] (const Record& x) { return x.id % 100 == 0; }) >> count, 100u);
+
+        std::vector<Record> v;
+        TRY(r >> collect >> overwrite(v));
+        TEST_EQUAL(v.size(), size_t(n));
+        TEST(std::memcmp(v.data(), records.data(), n * sizeof(Record)) == 0);
+
+        std::vector<double> w;
+        {
+            ParallelLimitsOverride limits(4, 1);
+            TRY(mapped_range<Record>(path, MapHint::random) >> map([] (const Record& x) { return x.value; }) >> par_collect >> overwrite(w));
+        }
+        TEST_EQUAL(w.size(), size_t(n));
+        TEST_EQUAL(w[777], 388.5);
+
+        TEST_EQUAL(std::remove(path.data()), 0);
+        TEST_THROW(mapped_range<Record>(path), std::system_error);
+
+    #endif
+
 }
 
 void test_rs_range_generation_random() {
@@ -149,6 +429,190 @@ void test_rs_range_generation_random() {
     TEST_NEAR(mean, 50, 0.1);
     TEST_NEAR(sd, 29.15, 0.1);
 
+    Xoshiro256x4 x1(42), x2(42);
+    std::vector<uint64_t> u1(1001), u2(1001);
+
+    TRY(x1());
+    TRY(x1.fill(u1.data(), u1.size()));
+    TRY(x2());
+    for (auto& u: u2)
+        TRY(u = x2());
+    TEST(u1 == u2);
+    TEST(x1() == x2());
+
+    x1.seed(42);
+    Xoshiro256x4 x3(42);
+    TEST_EQUAL(x1(), x3());
+    TEST(Xoshiro256x4(1)() != Xoshiro256x4(2)());
+
+    std::uniform_int_distribution<uint64_t> bits;
+    u1.assign(n, 0);
+    u2.clear();
+    x1.seed(99);
+    TRY(u1 << random(bits, x1));
+    x2.seed(99);
+    TRY(random(bits, x2, n) >> overwrite(u2));
+    TEST(u1 == u2);
+    double ones = 0;
+    for (auto u: u1)
+        for (; u != 0; u &= u - 1)
+            ++ones;
+    TEST_NEAR(ones / (64.0 * n), 0.5, 0.001);
+
+    Xoshiro256x4 x4(7);
+    v.assign(n, 0);
+    TRY(v << random(uid, x4));
+    TRY(stats(v, mean, sd));
+    TEST_NEAR(mean, 50, 0.2);
+    TEST_NEAR(sd, 29.15, 0.1);
+
+}
+
+void test_rs_range_generation_random_distributions() {
+
+    static constexpr size_t n = 100000;
+
+    Xoshiro256x4 x(42);
+    std::mt19937 mt(42);
+    std::vector<int> vi(n);
+    std::vector<uint64_t> vu(n);
+    std::vector<double> vd(n);
+    std::vector<float> vf(n);
+    double mean = 0, sd = 0;
+
+    UniformIntDistribution<int> uid(0, 100);
+    TRY(vi << random(uid, x));
+    TRY(stats(vi, mean, sd));
+    TEST_NEAR(mean, 50, 0.2);
+    TEST_NEAR(sd, 29.15, 0.1);
+    TEST_EQUAL(*std::min_element(vi.begin(), vi.end()), 0);
+    TEST_EQUAL(*std::max_element(vi.begin(), vi.end()), 100);
+    TRY(vi << random(uid, mt));
+    TRY(stats(vi, mean, sd));
+    TEST_NEAR(mean, 50, 0.2);
+    TEST_NEAR(sd, 29.15, 0.1);
+    TRY(random(uid, x, n) >> overwrite(vi));
+    TRY(stats(vi, mean, sd));
+    TEST_NEAR(mean, 50, 0.2);
+    TEST_NEAR(sd, 29.15, 0.1);
+
+    UniformIntDistribution<int> negative(-10, -8);
+    TRY(vi << random(negative, x));
+    TEST_EQUAL(*std::min_element(vi.begin(), vi.end()), -10);
+    TEST_EQUAL(*std::max_element(vi.begin(), vi.end()), -8);
+
+    UniformIntDistribution<uint64_t> wide(0, uint64_t(1) << 40);
+    TRY(vu << random(wide, x));
+    TRY(stats(vu, mean, sd));
+    TEST_NEAR(mean / std::ldexp(1.0, 40), 0.5, 0.01);
+
+    UniformRealDistribution<double> urd(-1, 3);
+    TRY(vd << random(urd, x));
+    TRY(stats(vd, mean, sd));
+    TEST_NEAR(mean, 1, 0.02);
+    TEST_NEAR(sd, 1.1547, 0.01);
+    TEST(*std::min_element(vd.begin(), vd.end()) >= -1);
+    TEST(*std::max_element(vd.begin(), vd.end()) < 3);
+
+    UniformRealDistribution<float> urf;
+    TRY(vf << random(urf, mt));
+    TRY(stats(vf, mean, sd));
+    TEST_NEAR(mean, 0.5, 0.01);
+    TEST_NEAR(sd, 0.2887, 0.01);
+
+    MaxEngine top;
+    TEST(urf(top) < 1.0f);
+    TEST(UniformRealDistribution<float>(-1, 1)(top) < 1.0f);
+    TEST(UniformRealDistribution<double>(0.1, 0.3)(top) < 0.3);
+    TRY(vf << random(urf, top));
+    TEST(*std::max_element(vf.begin(), vf.end()) < 1.0f);
+
+    NormalDistribution<double> nd(10, 2);
+    TRY(vd << random(nd, x));
+    TRY(stats(vd, mean, sd));
+    TEST_NEAR(mean, 10, 0.05);
+    TEST_NEAR(sd, 2, 0.05);
+    auto tail = std::count_if(vd.begin(), vd.end(), [] (double d) { return std::abs(d - 10) > 2 * 3.442619855899; });
+    TEST_NEAR(double(tail) / n, 5.76e-4, 3e-4);
+    TRY(random(nd, mt, n) >> overwrite(vd));
+    TRY(stats(vd, mean, sd));
+    TEST_NEAR(mean, 10, 0.05);
+    TEST_NEAR(sd, 2, 0.05);
+
+    std::unique_ptr<bool[]> flags(new bool[n]);
+    for (double p: {0.0, 0.1, 0.25, 0.5, 0.75, 1.0 / 3, 1.0}) {
+        BernoulliDistribution bd(p);
+        TRY(bd.generate(x, flags.get(), n));
+        auto hits = std::count(flags.get(), flags.get() + n, true);
+        TEST_NEAR(double(hits) / n, p, 0.01);
+        hits = 0;
+        for (size_t i = 0; i < n; ++i)
+            hits += bd(mt);
+        TEST_NEAR(double(hits) / n, p, 0.01);
+    }
+
+}
+
+void test_rs_range_generation_random_stream() {
+
+    using Block = std::array<uint32_t, 4>;
+
+    TEST((RS::Range::Detail::philox4x32({{0, 0, 0, 0}}, {{0, 0}}) == Block{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}));
+    TEST((RS::Range::Detail::philox4x32({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}, {{0xffffffff, 0xffffffff}})
+        == Block{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}));
+    TEST((RS::Range::Detail::philox4x32({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, {{0xa4093822, 0x299f31d0}})
+        == Block{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}));
+
+    PhiloxEngine e1(42), e2(42), e3(43), e4(42, 1);
+    uint64_t x = 0;
+
+    TRY(x = e1());
+    TEST_EQUAL(x, e2());
+    TEST(x != e3());
+    TEST(x != e4());
+    TEST_EQUAL(e1.split(1)(), e2.split(1)());
+    TEST(e1.split(1)() != e1.split(2)());
+    TEST(e1.split(1)() != PhiloxEngine(42, 1)());
+    TEST(PhiloxEngine(42, 0).split(1)() != PhiloxEngine(42, 5).split(1)());
+    auto f1 = e1.fork();
+    auto f2 = e1.fork();
+    TEST(f1.split(0)() != f2.split(0)());
+    TEST_EQUAL(f1.split(0)(), e2.fork().split(0)());
+    TEST_EQUAL(e4.stream(), 1u);
+
+    static constexpr size_t n = 100000;
+
+    std::uniform_real_distribution<double> urd(0, 1);
+    std::normal_distribution<double> nd(10, 2);
+    std::vector<double> v1, v2, v3;
+    double mean = 0, sd = 0;
+
+    auto r = random_stream(urd, 99, n);
+    TEST_EQUAL(r.end() - r.begin(), ptrdiff_t(n));
+    TRY(r >> overwrite(v1));
+    TEST_EQUAL(v1.size(), n);
+    TRY(stats(v1, mean, sd));
+    TEST_NEAR(mean, 0.5, 0.01);
+    TEST_NEAR(sd, 0.2887, 0.01);
+    TEST_EQUAL(r.begin()[12345], v1[12345]);
+    TEST_EQUAL(*(r.begin() + 777), v1[777]);
+    TEST_EQUAL(*(r.end() - 1), v1.back());
+    TRY(r >> skip(n - 10) >> overwrite(v2));
+    TEST(std::equal(v2.begin(), v2.end(), v1.end() - 10));
+
+    {
+        ParallelLimitsOverride limits(1, 1);
+        TRY(random_stream(nd, 7, n) >> par_collect >> overwrite(v2));
+    }
+    {
+        ParallelLimitsOverride limits(4, 1);
+        TRY(random_stream(nd, 7, n) >> par_collect >> overwrite(v3));
+    }
+    TEST(v2 == v3);
+    TRY(stats(v2, mean, sd));
+    TEST_NEAR(mean, 10, 0.05);
+    TEST_NEAR(sd, 2, 0.05);
+
 }
 
 void test_rs_range_generation_single() {
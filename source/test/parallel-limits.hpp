@@ -0,0 +1,19 @@
+#pragma once
+
+#include "rs-range/core.hpp"
+#include <cstddef>
+
+// Sets the parallel thread and grain limits for the lifetime of the object,
+// restoring the previous limits even if a test throws
+
+class ParallelLimitsOverride {
+public:
+    ParallelLimitsOverride(size_t threads, size_t grain): saved_(RS::Range::Detail::parallel_limits()) {
+        RS::Range::Detail::parallel_limits() = {threads, grain};
+    }
+    ~ParallelLimitsOverride() { RS::Range::Detail::parallel_limits() = saved_; }
+    ParallelLimitsOverride(const ParallelLimitsOverride&) = delete;
+    ParallelLimitsOverride& operator=(const ParallelLimitsOverride&) = delete;
+private:
+    RS::Range::Detail::ParallelLimits saved_;
+};
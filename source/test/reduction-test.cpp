@@ -1,9 +1,13 @@
 #include "rs-range/reduction.hpp"
+#include "rs-range/transformation.hpp"
 #include "rs-format/string.hpp"
 #include "rs-tl/iterator.hpp"
 #include "rs-unit-test.hpp"
+#include "test/parallel-limits.hpp"
 #include <functional>
+#include <list>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -100,6 +104,46 @@ void test_rs_range_reduction_is_sorted() {
 
 }
 
+void test_rs_range_reduction_join() {
+
+    using RS::Range::join;
+
+    std::vector<std::string> sv;
+    std::vector<std::string_view> vv = {"alpha", "bravo", "charlie"};
+    std::list<const char*> cl = {"x", "yy", "", "zzz"};
+    std::vector<std::wstring> wv = {L"one", L"two"};
+    std::string s;
+
+    TRY(s = sv >> join(","));                           TEST_EQUAL(s, "");
+    sv = {"hello"};            TRY(s = sv >> join(","));  TEST_EQUAL(s, "hello");
+    sv = {"hello", "world"};   TRY(s = sv >> join(","));  TEST_EQUAL(s, "hello,world");
+    sv = {"", "", ""};         TRY(s = sv >> join(","));  TEST_EQUAL(s, ",,");
+    sv = {"a", "b", "c"};      TRY(s = sv >> join(""));   TEST_EQUAL(s, "abc");
+    TRY(s = sv >> join(", "s));                        TEST_EQUAL(s, "a, b, c");
+    TRY(s = sv >> passthrough >> join(" :: "));        TEST_EQUAL(s, "a :: b :: c");
+    TRY(s = vv >> join("/"));                          TEST_EQUAL(s, "alpha/bravo/charlie");
+    TRY(s = cl >> join("|"));                          TEST_EQUAL(s, "x|yy||zzz");
+    TRY(s = sv >> map([] (const std::string& t) { return t + t; }) >> join("-"));  TEST_EQUAL(s, "aa-bb-cc");
+    int calls = 0;
+    TRY(s = sv >> map([&] (const std::string& t) { ++calls; return t; }) >> join(""));  TEST_EQUAL(s, "abc");
+    TEST_EQUAL(calls, 3);
+    TEST(wv >> join(L"+") == L"one+two");
+
+    std::string big;
+    sv.clear();
+    for (int i = 0; i < 1000; ++i)
+        sv.push_back(std::string(i % 13, char('a' + i % 26)));
+    for (size_t i = 0; i < sv.size(); ++i) {
+        if (i > 0)
+            big += "<>";
+        big += sv[i];
+    }
+    TRY(s = sv >> join("<>"));
+    TEST_EQUAL(s.size(), big.size());
+    TEST(s == big);
+
+}
+
 void test_rs_range_reduction_min_max() {
 
     std::string s0, s1 = "Hello world";
@@ -168,4 +212,29 @@ void test_rs_range_reduction_sum_product() {
     TRY(x = v1 >> (passthrough * product));       TEST_EQUAL(x, 120);
     TRY(x = v1 >> (passthrough * product(100)));  TEST_EQUAL(x, 12000);
 
+    TRY(x = v0 >> par_sum);                       TEST_EQUAL(x, 0);
+    TRY(x = v0 >> par_sum(100));                  TEST_EQUAL(x, 100);
+    TRY(x = v1 >> par_sum);                       TEST_EQUAL(x, 15);
+    TRY(x = v1 >> par_sum(100));                  TEST_EQUAL(x, 115);
+    TRY(x = v1 >> passthrough >> par_sum);        TEST_EQUAL(x, 15);
+    TRY(x = v1 >> passthrough >> par_sum(100));   TEST_EQUAL(x, 115);
+
+    std::vector<double> v2(100000);
+    double y1 = 0, y2 = 0;
+    for (size_t i = 0; i < v2.size(); ++i)
+        v2[i] = 1.0 / double(i + 1);
+    {
+        ParallelLimitsOverride limits(1, 1);
+        TRY(y1 = v2 >> par_sum);
+    }
+    {
+        ParallelLimitsOverride limits(4, 1);
+        TRY(y2 = v2 >> par_sum);
+        TEST_EQUAL(y1, y2);
+        TEST_NEAR(y1, v2 >> sum, 1e-9);
+        std::vector<int> v3(100000, 3);
+        TRY(x = v3 >> par_sum(100));
+        TEST_EQUAL(x, 300100);
+    }
+
 }
@@ -1,7 +1,9 @@
 #include "rs-range/selection.hpp"
+#include "rs-range/generation.hpp"
 #include "rs-format/string.hpp"
 #include "rs-tl/iterator.hpp"
 #include "rs-unit-test.hpp"
+#include "test/parallel-limits.hpp"
 #include <algorithm>
 #include <memory>
 #include <numeric>
@@ -302,6 +304,35 @@ void test_rs_range_selection_sample() {
         }
     }
 
+    PhiloxEngine counter1(123), counter2(123);
+
+    TRY(v1 >> sample_p(0.5, counter1) >> overwrite(v2));
+    TRY(v1 >> sample_p(0.5, counter2) >> overwrite(v3));
+    TEST(v2 == v3);
+    TEST_NEAR(double(v2.size()) / double(v1.size()), 0.5, 0.2);
+    TRY(v1 >> sample_p(0.5, counter1) >> overwrite(v3));
+    TEST(v2 != v3);
+    TRY(v1 >> sample_p(0.5, counter1) >> overwrite(v2));
+    v3 = v1;
+    TRY(v3 << sample_p(0.5, counter2));
+    v3 = v1;
+    TRY(v3 << sample_p(0.5, counter2));
+    TEST(v2 == v3);
+
+    {
+        ParallelLimitsOverride limits(1, 1);
+        TRY(v1 >> sample_replace(1000, counter1) >> overwrite(v2));
+    }
+    {
+        ParallelLimitsOverride limits(4, 1);
+        TRY(v1 >> sample_replace(1000, counter2) >> overwrite(v3));
+    }
+    TEST_EQUAL(v2.size(), 1000u);
+    TEST(v2 == v3);
+    TEST(std::all_of(v2.begin(), v2.end(), [] (int x) { return x >= 1 && x <= 100; }));
+    TRY(v1 >> sample_replace(1000, counter1) >> overwrite(v3));
+    TEST(v2 != v3);
+
 }
 
 void test_rs_range_selection_skip_take() {
@@ -12,6 +12,7 @@ int main(int argc, char** argv) {
     UNIT_TEST(rs_range_core_passthrough)
     UNIT_TEST(rs_range_core_collect)
     UNIT_TEST(rs_range_core_each)
+    UNIT_TEST(rs_range_core_parallel)
     UNIT_TEST(rs_range_core_combinator)
 
     // aggregation-test.cpp
@@ -20,19 +21,24 @@ int main(int argc, char** argv) {
     UNIT_TEST(rs_range_aggregation_collect_groups)
     UNIT_TEST(rs_range_aggregation_group)
     UNIT_TEST(rs_range_aggregation_partial_sum)
+    UNIT_TEST(rs_range_aggregation_split)
 
     // combination-test.cpp
+    UNIT_TEST(rs_range_combination_cartesian_product)
     UNIT_TEST(rs_range_combination_compare)
     UNIT_TEST(rs_range_combination_concat)
+    UNIT_TEST(rs_range_combination_hash_join)
     UNIT_TEST(rs_range_combination_inner_product)
     UNIT_TEST(rs_range_combination_interleave)
     UNIT_TEST(rs_range_combination_merge)
+    UNIT_TEST(rs_range_combination_merge_join)
     UNIT_TEST(rs_range_combination_outer_product)
     UNIT_TEST(rs_range_combination_set_difference)
     UNIT_TEST(rs_range_combination_set_difference_from)
     UNIT_TEST(rs_range_combination_set_intersection)
     UNIT_TEST(rs_range_combination_set_symmetric_difference)
     UNIT_TEST(rs_range_combination_set_union)
+    UNIT_TEST(rs_range_combination_soa)
     UNIT_TEST(rs_range_combination_zip)
 
     // expansion-test.cpp
@@ -40,16 +46,23 @@ int main(int argc, char** argv) {
     UNIT_TEST(rs_range_expansion_flat_map)
     UNIT_TEST(rs_range_expansion_flatten)
     UNIT_TEST(rs_range_expansion_insert_algorithms)
+    UNIT_TEST(rs_range_expansion_mask_subsets)
     UNIT_TEST(rs_range_expansion_permutations)
     UNIT_TEST(rs_range_expansion_repeat)
+    UNIT_TEST(rs_range_expansion_revolving_door)
     UNIT_TEST(rs_range_expansion_subsets)
 
     // generation-test.cpp
     UNIT_TEST(rs_range_generation_epsilon)
     UNIT_TEST(rs_range_generation_fill)
     UNIT_TEST(rs_range_generation_generate)
+    UNIT_TEST(rs_range_generation_generator)
     UNIT_TEST(rs_range_generation_iota)
+    UNIT_TEST(rs_range_generation_lines)
+    UNIT_TEST(rs_range_generation_mapped_range)
     UNIT_TEST(rs_range_generation_random)
+    UNIT_TEST(rs_range_generation_random_distributions)
+    UNIT_TEST(rs_range_generation_random_stream)
     UNIT_TEST(rs_range_generation_single)
 
     // permutation-test.cpp
@@ -64,6 +77,7 @@ int main(int argc, char** argv) {
     UNIT_TEST(rs_range_reduction_fold)
     UNIT_TEST(rs_range_reduction_is_empty)
     UNIT_TEST(rs_range_reduction_is_sorted)
+    UNIT_TEST(rs_range_reduction_join)
     UNIT_TEST(rs_range_reduction_min_max)
     UNIT_TEST(rs_range_reduction_reduce)
     UNIT_TEST(rs_range_reduction_sum_product)